@@ -0,0 +1,359 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Benchmark of the path between the kernel emitting a remove@ uevent and the
+ * blue screen reaching the X server. A child process plays the kernel: for
+ * every iteration, it sends a burst of unrelated uevents followed by the
+ * removal of the watched block device over a socketpair. The parent handles
+ * them with the same code root-vanished uses and reports per-stage latency.
+ *
+ * Run against a throwaway X server, e.g.:
+ *   xvfb-run -s "-screen 0 3840x2160x24" ./root-vanished-bench
+ *
+ */
+#include <unistd.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <err.h>
+#include <time.h>
+#include <sys/poll.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/sysmacros.h>
+#include <xcb/xcb.h>
+#include <xcb/xcb_aux.h>
+
+#include "blockdev.h"
+#include "watchset.h"
+#include "wait_for_blockdev_removal.h"
+#include "message_layout.h"
+#include "prepare_message_window.h"
+#include "copy_message_tiles.h"
+
+enum stage { STAGE_RECV, STAGE_MATCH, STAGE_MAP, STAGE_COPY_AREA, STAGE_FLUSH,
+             STAGE_TOTAL, NUM_STAGES };
+
+static const char *stage_names[NUM_STAGES] = {
+    "recv", "match", "map", "copy_area", "flush", "total",
+};
+
+/* The synthetic removal is for sdb1 on a USB stick, watched with its
+ * ancestry like resolve_blockdev_ancestry() would set it up. */
+#define STICK_DEVPATH "/devices/pci0000:00/0000:00:14.0/usb2/2-1"
+#define SCSI_DEVPATH STICK_DEVPATH "/2-1:1.0/host6/target6:0:0/6:0:0:0"
+#define DISK_DEVPATH SCSI_DEVPATH "/block/sdb"
+static char *devpaths[] = {
+    DISK_DEVPATH "/sdb1",
+    DISK_DEVPATH,
+    SCSI_DEVPATH,
+    STICK_DEVPATH "/2-1:1.0/host6/target6:0:0",
+    STICK_DEVPATH "/2-1:1.0/host6",
+    STICK_DEVPATH "/2-1:1.0",
+    STICK_DEVPATH,
+    "/devices/pci0000:00/0000:00:14.0/usb2",
+    "/devices/pci0000:00/0000:00:14.0",
+    "/devices/pci0000:00",
+};
+static struct blockdev blockdev = {
+    .name = "sdb1",
+    .devpaths = devpaths,
+    .num_devpaths = sizeof(devpaths) / sizeof(devpaths[0]),
+};
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void send_uevent(int fd, const char *payload, size_t len) {
+  if (send(fd, payload, len, 0) != (ssize_t)len) {
+    err(EXIT_FAILURE, "send");
+  }
+}
+
+/*
+ * Sends one burst per byte read from ctl_fd, until ctl_fd is closed. The
+ * payloads mimic what the kernel sends when a USB hub with a stick and a
+ * keyboard behind it is unplugged while on battery.
+ *
+ */
+static void inject_uevents(int ctl_fd, int uevent_fd, int noise) {
+  static const char power_supply[] =
+      "change@/devices/LNXSYSTM:00/LNXSYBUS:00/PNP0C0A:00/power_supply/BAT0\0"
+      "ACTION=change\0"
+      "DEVPATH=/devices/LNXSYSTM:00/LNXSYBUS:00/PNP0C0A:00/power_supply/BAT0\0"
+      "SUBSYSTEM=power_supply\0"
+      "POWER_SUPPLY_NAME=BAT0\0"
+      "POWER_SUPPLY_STATUS=Discharging\0"
+      "POWER_SUPPLY_CAPACITY=87\0";
+  static const char input[] =
+      "remove@/devices/pci0000:00/0000:00:14.0/usb1/1-2/1-2:1.0/"
+      "0003:046D:C31C.0001/input/input23\0"
+      "ACTION=remove\0"
+      "DEVPATH=/devices/pci0000:00/0000:00:14.0/usb1/1-2/1-2:1.0/"
+      "0003:046D:C31C.0001/input/input23\0"
+      "SUBSYSTEM=input\0"
+      "PRODUCT=3/46d/c31c/110\0";
+  char removal[1024];
+  uint64_t seqnum = 0;
+  char c;
+
+  while (read(ctl_fd, &c, 1) == 1) {
+    for (int i = 0; i < noise; i++) {
+      if (i % 2 == 0) {
+        send_uevent(uevent_fd, power_supply, sizeof(power_supply));
+      } else {
+        send_uevent(uevent_fd, input, sizeof(input));
+      }
+    }
+    /* The noise is not part of the latency: t0 is when the removal is
+     * emitted, formatting it into the payload takes negligible time. */
+    const uint64_t t0 = now_ns();
+    const char *devpath = DISK_DEVPATH;
+    const int len = snprintf(
+        removal, sizeof(removal),
+        "remove@%s/%s%c"
+        "ACTION=remove%c"
+        "DEVPATH=%s/%s%c"
+        "SUBSYSTEM=block%c"
+        "DEVNAME=%s%c"
+        "DEVTYPE=partition%c"
+        "MAJOR=8%c"
+        "MINOR=17%c"
+        "SEQNUM=%" PRIu64 "%c"
+        "BENCH_T0=%" PRIu64 "%c",
+        devpath, blockdev.name, '\0', '\0', devpath, blockdev.name, '\0', '\0',
+        blockdev.name, '\0', '\0', '\0', '\0', ++seqnum, '\0', t0, '\0');
+    if (len < 0 || len >= (int)sizeof(removal)) {
+      errx(EXIT_FAILURE, "uevent payload does not fit");
+    }
+    send_uevent(uevent_fd, removal, len + 1);
+  }
+}
+
+/*
+ * Returns the value of the BENCH_T0 key which inject_uevents() appends to the
+ * removal uevent.
+ *
+ */
+static uint64_t bench_t0(const char *buf, size_t len) {
+  const char *key = "BENCH_T0=";
+  for (size_t off = 0; off < len; off += strnlen(buf + off, len - off) + 1) {
+    if (strncmp(buf + off, key, strlen(key)) == 0) {
+      return strtoull(buf + off + strlen(key), NULL, 10);
+    }
+  }
+  errx(EXIT_FAILURE, "removal uevent without BENCH_T0");
+}
+
+static int compare_u64(const void *a, const void *b) {
+  const uint64_t x = *(const uint64_t *)a;
+  const uint64_t y = *(const uint64_t *)b;
+  return (x > y) - (x < y);
+}
+
+static void report(uint64_t *samples[NUM_STAGES], int iterations) {
+  printf("%-10s %12s %12s %12s\n", "stage", "p50 [us]", "p99 [us]",
+         "max [us]");
+  for (int s = 0; s < NUM_STAGES; s++) {
+    uint64_t *v = samples[s];
+    qsort(v, iterations, sizeof(uint64_t), compare_u64);
+    printf("%-10s %12.1f %12.1f %12.1f\n", stage_names[s],
+           v[iterations / 2] / 1000.0, v[(iterations * 99) / 100] / 1000.0,
+           v[iterations - 1] / 1000.0);
+  }
+}
+
+void usage(void) {
+  printf("root-vanished-bench [options]\n");
+  printf("\n");
+  printf("Measures the latency between a (synthetic) removal uevent and the "
+         "blue screen being drawn by the X server in $DISPLAY.\n");
+  printf("\n");
+  printf("Options:\n");
+  printf("\t--iterations\tNumber of removals to measure. (default: 1000)\n");
+  printf("\t--noise\tNumber of unrelated uevents sent before each removal. "
+         "(default: 16)\n");
+  printf("\t--builtin_font\tRender the message with the compiled-in font. "
+         "(default: false)\n");
+}
+
+int main(int argc, char *argv[]) {
+  int iterations = 1000;
+  int noise = 16;
+  bool builtin_font = false;
+  int option_index = 0;
+  int opt;
+  const struct option options[] = {
+      {"iterations", required_argument, NULL, 'i'},
+      {"noise", required_argument, NULL, 'n'},
+      {"builtin_font", no_argument, NULL, 'b'},
+      {"help", no_argument, NULL, 'h'},
+      {0, 0, 0, 0},
+  };
+
+  while ((opt = getopt_long(argc, argv, "h", options, &option_index)) != -1) {
+    switch (opt) {
+    case 'i':
+      iterations = atoi(optarg);
+      break;
+
+    case 'n':
+      noise = atoi(optarg);
+      break;
+
+    case 'b':
+      builtin_font = true;
+      break;
+
+    case 'h':
+      usage();
+      return 0;
+
+    default:
+      usage();
+      return 1;
+    }
+  }
+  if (iterations < 1 || noise < 0) {
+    errx(EXIT_FAILURE, "--iterations must be positive, --noise non-negative");
+  }
+  blockdev.devnum = makedev(8, 17);
+  struct watchset watchset = {0};
+  watchset_add(&watchset, &blockdev);
+  watchset_build(&watchset);
+
+  int uevent_fds[2];
+  if (socketpair(AF_UNIX, SOCK_DGRAM, 0, uevent_fds) == -1) {
+    err(EXIT_FAILURE, "socketpair");
+  }
+  /* Filter like the netlink socket does, so unrelated uevents are dropped
+   * in the kernel before they wake us up. */
+  uevent_socket_attach_filter(uevent_fds[0]);
+  int ctl_fds[2];
+  if (pipe(ctl_fds) == -1) {
+    err(EXIT_FAILURE, "pipe");
+  }
+  const pid_t child = fork();
+  if (child == -1) {
+    err(EXIT_FAILURE, "fork");
+  }
+  if (child == 0) {
+    close(ctl_fds[1]);
+    close(uevent_fds[0]);
+    inject_uevents(ctl_fds[0], uevent_fds[1], noise);
+    _exit(0);
+  }
+  close(ctl_fds[0]);
+  close(uevent_fds[1]);
+
+  int conn_screen;
+  xcb_connection_t *conn = xcb_connect(NULL, &conn_screen);
+  if (xcb_connection_has_error(conn))
+    errx(EXIT_FAILURE, "Cannot open display\n");
+
+  const xcb_screen_t *root_screen = xcb_aux_get_screen(conn, conn_screen);
+  const int screen_width = root_screen->width_in_pixels;
+  const int screen_height = root_screen->height_in_pixels;
+  const xcb_window_t window = xcb_generate_id(conn);
+  const xcb_pixmap_t pixmap = xcb_generate_id(conn);
+  const xcb_gcontext_t pixmap_gc = xcb_generate_id(conn);
+  struct message_layout layout;
+  const bool prerendered =
+      prepare_message_window(conn, root_screen, window, pixmap, pixmap_gc,
+                             &layout, false, builtin_font);
+
+  uint64_t *samples[NUM_STAGES];
+  for (int s = 0; s < NUM_STAGES; s++) {
+    if ((samples[s] = calloc(iterations, sizeof(uint64_t))) == NULL) {
+      err(EXIT_FAILURE, "calloc");
+    }
+  }
+
+  struct pollfd pfd = {.fd = uevent_fds[0], .events = POLLIN};
+  for (int i = 0; i < iterations; i++) {
+    if (write(ctl_fds[1], "x", 1) != 1) {
+      err(EXIT_FAILURE, "write");
+    }
+
+    /* recv covers waiting for and receiving all uevents of the burst, match
+     * covers running all of them through the matcher. Both go through the
+     * same batched functions as uevent_socket_read(). */
+    uint64_t match_ns = 0;
+    uint64_t t0 = 0;
+    uint64_t detected = 0;
+    while (t0 == 0) {
+      if (poll(&pfd, 1, -1) == -1) {
+        err(EXIT_FAILURE, "poll");
+      }
+      struct uevent_batch batch;
+      if (uevent_socket_recv(pfd.fd, &batch) == -1) {
+        errx(EXIT_FAILURE, "uevents were lost (receive buffer full)");
+      }
+      const uint64_t received = now_ns();
+      int matched;
+      const bool removed =
+          (uevent_batch_match(&batch, &watchset, &matched) != NULL);
+      detected = now_ns();
+      match_ns += detected - received;
+      if (removed) {
+        t0 = bench_t0(batch.bufs[matched], batch.lens[matched]);
+      }
+    }
+
+    xcb_map_window(conn, window);
+    xcb_configure_window(conn, window, XCB_CONFIG_WINDOW_STACK_MODE,
+                         (uint32_t[]){XCB_STACK_MODE_ABOVE});
+    const uint64_t mapped = now_ns();
+    if (!prerendered) {
+      copy_message_tiles(conn, pixmap, window, pixmap_gc, &layout);
+    }
+    const uint64_t copied = now_ns();
+    /* Wait for a reply so that the server has processed all requests. */
+    xcb_aux_sync(conn);
+    const uint64_t flushed = now_ns();
+
+    samples[STAGE_RECV][i] = detected - t0 - match_ns;
+    samples[STAGE_MATCH][i] = match_ns;
+    samples[STAGE_MAP][i] = mapped - detected;
+    samples[STAGE_COPY_AREA][i] = copied - mapped;
+    samples[STAGE_FLUSH][i] = flushed - copied;
+    samples[STAGE_TOTAL][i] = flushed - t0;
+
+    xcb_unmap_window(conn, window);
+    xcb_aux_sync(conn);
+  }
+
+  close(ctl_fds[1]);
+  waitpid(child, NULL, 0);
+  xcb_disconnect(conn);
+
+  printf("%d removals, %d unrelated uevents each, %dx%d screen, %d outputs, "
+         "%dx%d tiles (%s)\n",
+         iterations, noise, screen_width, screen_height, layout.num_outputs,
+         layout.message_width, layout.message_height,
+         (prerendered ? "prerendered background" : "copied on map"));
+  report(samples, iterations);
+  return 0;
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdint.h>
+#include <xcb/xcb.h>
+
+#include "bitmap_font.h"
+#include "bitmap_font_glyphs.h"
+
+/* Index of the first Latin-1 glyph, following the 95 ASCII ones */
+#define LATIN1_INDEX (0x7F - 0x20)
+
+/*
+ * Returns the glyph for the given UCS-2 character (as produced by
+ * utf8_to_ucs2()), or the glyph of '?' if the font does not cover it.
+ *
+ */
+const uint8_t *bitmap_font_glyph(xcb_char2b_t c) {
+  if (c.byte1 == 0) {
+    if (c.byte2 >= 0x20 && c.byte2 < 0x7F) {
+      return glyphs[c.byte2 - 0x20];
+    }
+    if (c.byte2 >= 0xA0) {
+      return glyphs[LATIN1_INDEX + c.byte2 - 0xA0];
+    }
+  }
+  return glyphs['?' - 0x20];
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+/* Cell size and baseline of the compiled-in font, see bitmap_font.c */
+#define BITMAP_FONT_WIDTH 8
+#define BITMAP_FONT_HEIGHT 16
+#define BITMAP_FONT_ASCENT 12
+
+const uint8_t *bitmap_font_glyph(xcb_char2b_t c);
@@ -0,0 +1,633 @@
+/*
+ * Glyphs of the compiled-in font used by bitmap_font.c: printable ASCII
+ * (U+0020..U+007E) and Latin-1 (U+00A0..U+00FF), rasterized from DejaVu Sans
+ * Mono Bold at 13 pixels (FreeType, monochrome, hinted) into cells of
+ * BITMAP_FONT_WIDTH x BITMAP_FONT_HEIGHT pixels. One byte per row, the most
+ * significant bit is the leftmost pixel.
+ *
+ * The glyph data is derived from the DejaVu fonts and therefore distributed
+ * under their license, not under the Apache License of the rest of
+ * root-vanished:
+ *
+ * Copyright (c) 2003 by Bitstream, Inc. All Rights Reserved.
+ * Bitstream Vera is a trademark of Bitstream, Inc.
+ * DejaVu changes are in public domain.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of the fonts accompanying this license ("Fonts") and associated
+ * documentation files (the "Font Software"), to reproduce and distribute the
+ * Font Software, including without limitation the rights to use, copy, merge,
+ * publish, distribute, and/or sell copies of the Font Software, and to permit
+ * persons to whom the Font Software is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright and trademark notices and this permission notice shall
+ * be included in all copies of one or more of the Font Software typefaces.
+ *
+ * The Font Software may be modified, altered, or added to, and in particular
+ * the designs of glyphs or characters in the Fonts may be modified and
+ * additional glyphs or characters may be added to the Fonts, only if the fonts
+ * are renamed to names not containing either the words "Bitstream" or the word
+ * "Vera".
+ *
+ * This License becomes null and void to the extent applicable to Fonts or Font
+ * Software that has been modified and is distributed under the "Bitstream
+ * Vera" names.
+ *
+ * The Font Software may be sold as part of a larger software package but no
+ * copy of one or more of the Font Software typefaces may be sold by itself.
+ *
+ * THE FONT SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF COPYRIGHT, PATENT,
+ * TRADEMARK, OR OTHER RIGHT. IN NO EVENT SHALL BITSTREAM OR THE GNOME
+ * FOUNDATION BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, INCLUDING
+ * ANY GENERAL, SPECIAL, INDIRECT, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * THE USE OR INABILITY TO USE THE FONT SOFTWARE OR FROM OTHER DEALINGS IN THE
+ * FONT SOFTWARE.
+ *
+ * Except as contained in this notice, the names of Gnome, the Gnome
+ * Foundation, and Bitstream Inc., shall not be used in advertising or
+ * otherwise to promote the sale, use or other dealings in this Font Software
+ * without prior written authorization from the Gnome Foundation or Bitstream
+ * Inc., respectively. For further information, contact: fonts at gnome dot
+ * org.
+ */
+#pragma once
+
+static const uint8_t glyphs[][BITMAP_FONT_HEIGHT] = {
+    /* U+0020 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0021 */
+    {0x00, 0x00, 0x00, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x00, 0x18, 0x18,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0022 */
+    {0x00, 0x00, 0x00, 0x66, 0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0023 */
+    {0x00, 0x00, 0x00, 0x00, 0x12, 0x16, 0x7F, 0x34, 0x24, 0xFE, 0x68, 0x48,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0024 */
+    {0x00, 0x00, 0x08, 0x08, 0x3E, 0x6A, 0x68, 0x3E, 0x0B, 0x0B, 0x6B, 0x3E,
+     0x08, 0x08, 0x00, 0x00},
+    /* U+0025 */
+    {0x00, 0x00, 0x00, 0x60, 0x90, 0x90, 0x63, 0x1C, 0xE6, 0x09, 0x09, 0x06,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0026 */
+    {0x00, 0x00, 0x00, 0x1C, 0x30, 0x30, 0x18, 0x39, 0x6D, 0x67, 0x66, 0x3F,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0027 */
+    {0x00, 0x00, 0x00, 0x18, 0x18, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0028 */
+    {0x00, 0x08, 0x18, 0x10, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x10, 0x18,
+     0x08, 0x00, 0x00, 0x00},
+    /* U+0029 */
+    {0x00, 0x10, 0x18, 0x08, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x08, 0x18,
+     0x10, 0x00, 0x00, 0x00},
+    /* U+002A */
+    {0x00, 0x00, 0x00, 0x10, 0xD6, 0x7C, 0x7C, 0xD6, 0x10, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+002B */
+    {0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x18, 0xFF, 0xFF, 0x18, 0x18, 0x18,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+002C */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18,
+     0x10, 0x20, 0x00, 0x00},
+    /* U+002D */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x3C, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+002E */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+002F */
+    {0x00, 0x00, 0x00, 0x02, 0x04, 0x04, 0x08, 0x08, 0x18, 0x10, 0x10, 0x20,
+     0x20, 0x40, 0x00, 0x00},
+    /* U+0030 */
+    {0x00, 0x00, 0x00, 0x1C, 0x36, 0x63, 0x6B, 0x6B, 0x63, 0x63, 0x36, 0x1C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0031 */
+    {0x00, 0x00, 0x00, 0x78, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x7E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0032 */
+    {0x00, 0x00, 0x00, 0x3E, 0x43, 0x03, 0x02, 0x06, 0x0C, 0x18, 0x30, 0x7F,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0033 */
+    {0x00, 0x00, 0x00, 0x3E, 0x43, 0x03, 0x1C, 0x07, 0x03, 0x03, 0x47, 0x3E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0034 */
+    {0x00, 0x00, 0x00, 0x0E, 0x0E, 0x1E, 0x36, 0x66, 0x7F, 0x06, 0x06, 0x06,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0035 */
+    {0x00, 0x00, 0x00, 0x7E, 0x60, 0x60, 0x7C, 0x47, 0x03, 0x03, 0x47, 0x3C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0036 */
+    {0x00, 0x00, 0x00, 0x1C, 0x32, 0x60, 0x7E, 0x63, 0x63, 0x63, 0x23, 0x1E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0037 */
+    {0x00, 0x00, 0x00, 0x7F, 0x03, 0x06, 0x06, 0x0C, 0x0C, 0x18, 0x18, 0x30,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0038 */
+    {0x00, 0x00, 0x00, 0x3E, 0x63, 0x63, 0x1C, 0x63, 0x63, 0x63, 0x63, 0x3E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0039 */
+    {0x00, 0x00, 0x00, 0x3C, 0x62, 0x63, 0x63, 0x63, 0x3F, 0x03, 0x26, 0x1C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+003A */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00, 0x00, 0x18, 0x18,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+003B */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00, 0x00, 0x18, 0x18,
+     0x10, 0x20, 0x00, 0x00},
+    /* U+003C */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x0F, 0x3C, 0x60, 0x3C, 0x0F, 0x01,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+003D */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0x7F, 0x00, 0x7F, 0x7F, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+003E */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x78, 0x1E, 0x03, 0x1E, 0x78, 0x40,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+003F */
+    {0x00, 0x00, 0x00, 0x1C, 0x26, 0x06, 0x0C, 0x18, 0x18, 0x00, 0x18, 0x18,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0040 */
+    {0x00, 0x00, 0x00, 0x3C, 0x62, 0x5E, 0xB6, 0xA2, 0xA2, 0xA2, 0xB6, 0x5E,
+     0x62, 0x3E, 0x00, 0x00},
+    /* U+0041 */
+    {0x00, 0x00, 0x00, 0x1C, 0x1C, 0x14, 0x36, 0x36, 0x3E, 0x36, 0x63, 0x63,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0042 */
+    {0x00, 0x00, 0x00, 0x7E, 0x63, 0x63, 0x63, 0x7C, 0x63, 0x63, 0x63, 0x7E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0043 */
+    {0x00, 0x00, 0x00, 0x1E, 0x31, 0x60, 0x60, 0x60, 0x60, 0x60, 0x31, 0x1E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0044 */
+    {0x00, 0x00, 0x00, 0x7C, 0x66, 0x63, 0x63, 0x63, 0x63, 0x63, 0x66, 0x7C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0045 */
+    {0x00, 0x00, 0x00, 0x7F, 0x60, 0x60, 0x60, 0x7E, 0x60, 0x60, 0x60, 0x7F,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0046 */
+    {0x00, 0x00, 0x00, 0x7F, 0x60, 0x60, 0x60, 0x7E, 0x60, 0x60, 0x60, 0x60,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0047 */
+    {0x00, 0x00, 0x00, 0x1E, 0x31, 0x60, 0x60, 0x67, 0x63, 0x63, 0x33, 0x1F,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0048 */
+    {0x00, 0x00, 0x00, 0x63, 0x63, 0x63, 0x63, 0x7F, 0x63, 0x63, 0x63, 0x63,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0049 */
+    {0x00, 0x00, 0x00, 0x7E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x7E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+004A */
+    {0x00, 0x00, 0x00, 0x0F, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x43, 0x3E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+004B */
+    {0x00, 0x00, 0x00, 0x63, 0x66, 0x6C, 0x78, 0x7C, 0x6C, 0x66, 0x66, 0x63,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+004C */
+    {0x00, 0x00, 0x00, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x7F,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+004D */
+    {0x00, 0x00, 0x00, 0x77, 0x77, 0x77, 0x77, 0x7F, 0x6B, 0x63, 0x63, 0x63,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+004E */
+    {0x00, 0x00, 0x00, 0x73, 0x73, 0x73, 0x7B, 0x6B, 0x6F, 0x67, 0x67, 0x67,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+004F */
+    {0x00, 0x00, 0x00, 0x1C, 0x36, 0x63, 0x63, 0x63, 0x63, 0x63, 0x36, 0x1C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0050 */
+    {0x00, 0x00, 0x00, 0x7E, 0x63, 0x63, 0x63, 0x63, 0x7E, 0x60, 0x60, 0x60,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0051 */
+    {0x00, 0x00, 0x00, 0x1C, 0x36, 0x63, 0x63, 0x63, 0x63, 0x63, 0x36, 0x1E,
+     0x06, 0x02, 0x00, 0x00},
+    /* U+0052 */
+    {0x00, 0x00, 0x00, 0x7E, 0x63, 0x63, 0x63, 0x63, 0x7C, 0x66, 0x63, 0x61,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0053 */
+    {0x00, 0x00, 0x00, 0x3E, 0x61, 0x60, 0x70, 0x3E, 0x07, 0x03, 0x43, 0x3E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0054 */
+    {0x00, 0x00, 0x00, 0x7E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0055 */
+    {0x00, 0x00, 0x00, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x3E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0056 */
+    {0x00, 0x00, 0x00, 0x63, 0x63, 0x22, 0x36, 0x36, 0x36, 0x14, 0x1C, 0x1C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0057 */
+    {0x00, 0x00, 0x00, 0xC3, 0xC3, 0xDB, 0xDB, 0x5A, 0x5E, 0x66, 0x66, 0x66,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0058 */
+    {0x00, 0x00, 0x00, 0x63, 0x36, 0x36, 0x1C, 0x08, 0x1C, 0x36, 0x36, 0x63,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0059 */
+    {0x00, 0x00, 0x00, 0xC3, 0x66, 0x66, 0x3C, 0x3C, 0x18, 0x18, 0x18, 0x18,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+005A */
+    {0x00, 0x00, 0x00, 0x7F, 0x03, 0x06, 0x0C, 0x1C, 0x18, 0x30, 0x60, 0x7F,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+005B */
+    {0x00, 0x1E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+     0x1E, 0x00, 0x00, 0x00},
+    /* U+005C */
+    {0x00, 0x00, 0x00, 0x60, 0x20, 0x20, 0x30, 0x10, 0x18, 0x08, 0x0C, 0x04,
+     0x04, 0x06, 0x00, 0x00},
+    /* U+005D */
+    {0x00, 0x38, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+     0x38, 0x00, 0x00, 0x00},
+    /* U+005E */
+    {0x00, 0x00, 0x00, 0x38, 0x38, 0x6C, 0xC6, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+005F */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0xFF, 0x00},
+    /* U+0060 */
+    {0x00, 0x00, 0x30, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0061 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x26, 0x06, 0x3E, 0x66, 0x66, 0x3E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0062 */
+    {0x00, 0x60, 0x60, 0x60, 0x60, 0x7C, 0x66, 0x66, 0x66, 0x66, 0x66, 0x7C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0063 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x32, 0x60, 0x60, 0x60, 0x32, 0x1C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0064 */
+    {0x00, 0x06, 0x06, 0x06, 0x06, 0x3E, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0065 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x66, 0x66, 0x7E, 0x60, 0x62, 0x3C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0066 */
+    {0x00, 0x0E, 0x18, 0x18, 0x18, 0x7E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0067 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x3E, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3E,
+     0x06, 0x06, 0x3C, 0x00},
+    /* U+0068 */
+    {0x00, 0x60, 0x60, 0x60, 0x60, 0x7C, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0069 */
+    {0x00, 0x18, 0x18, 0x00, 0x00, 0x78, 0x18, 0x18, 0x18, 0x18, 0x18, 0x7E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+006A */
+    {0x00, 0x0C, 0x0C, 0x00, 0x00, 0x3C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C,
+     0x0C, 0x0C, 0x78, 0x00},
+    /* U+006B */
+    {0x00, 0x60, 0x60, 0x60, 0x60, 0x64, 0x6C, 0x78, 0x78, 0x6C, 0x6C, 0x66,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+006C */
+    {0x00, 0xF0, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x1E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+006D */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xDB, 0xDB, 0xDB, 0xDB, 0xDB, 0xDB,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+006E */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x7C, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+006F */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0070 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x7C, 0x66, 0x66, 0x66, 0x66, 0x66, 0x7C,
+     0x60, 0x60, 0x60, 0x00},
+    /* U+0071 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x3E, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3E,
+     0x06, 0x06, 0x06, 0x00},
+    /* U+0072 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x3E, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0073 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x62, 0x70, 0x3C, 0x06, 0x46, 0x3C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0074 */
+    {0x00, 0x00, 0x00, 0x18, 0x18, 0x7E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x0E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0075 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0076 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x66, 0x66, 0x24, 0x3C, 0x3C, 0x18, 0x18,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0077 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0xC3, 0xC3, 0xDB, 0x5A, 0x5A, 0x66, 0x66,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0078 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x66, 0x3C, 0x18, 0x18, 0x3C, 0x3C, 0x66,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+0079 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x66, 0x66, 0x2C, 0x3C, 0x3C, 0x18, 0x18,
+     0x18, 0x30, 0x70, 0x00},
+    /* U+007A */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x7E, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x7E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+007B */
+    {0x00, 0x0E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x60, 0x18, 0x18, 0x18, 0x18,
+     0x1E, 0x00, 0x00, 0x00},
+    /* U+007C */
+    {0x00, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+     0x10, 0x10, 0x00, 0x00},
+    /* U+007D */
+    {0x00, 0x70, 0x18, 0x18, 0x18, 0x18, 0x18, 0x06, 0x18, 0x18, 0x18, 0x18,
+     0x78, 0x00, 0x00, 0x00},
+    /* U+007E */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39, 0x46, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00A0 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00A1 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x18, 0x18, 0x18, 0x18,
+     0x18, 0x18, 0x00, 0x00},
+    /* U+00A2 */
+    {0x00, 0x00, 0x00, 0x08, 0x08, 0x3C, 0x6A, 0x68, 0x68, 0x68, 0x6A, 0x3C,
+     0x08, 0x08, 0x00, 0x00},
+    /* U+00A3 */
+    {0x00, 0x00, 0x00, 0x1C, 0x32, 0x30, 0x30, 0x7C, 0x30, 0x30, 0x30, 0x7E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00A4 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x3E, 0x24, 0x24, 0x3C, 0x46, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00A5 */
+    {0x00, 0x00, 0x00, 0xC3, 0x66, 0x66, 0xFF, 0x18, 0xFF, 0x18, 0x18, 0x18,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00A6 */
+    {0x00, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10, 0x10, 0x00, 0x00, 0x10, 0x10,
+     0x10, 0x10, 0x10, 0x00},
+    /* U+00A7 */
+    {0x00, 0x00, 0x00, 0x3C, 0x60, 0x30, 0x3C, 0x6E, 0x66, 0x3C, 0x0C, 0x06,
+     0x3C, 0x00, 0x00, 0x00},
+    /* U+00A8 */
+    {0x00, 0x00, 0x36, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00A9 */
+    {0x00, 0x00, 0x00, 0x3C, 0x42, 0x9D, 0xA1, 0xA1, 0x9D, 0x42, 0x3C, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00AA */
+    {0x00, 0x00, 0x00, 0x1C, 0x02, 0x3E, 0x22, 0x3E, 0x00, 0x1E, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00AB */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x12, 0x36, 0x6C, 0x6C, 0x36, 0x12, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00AC */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0x7F, 0x03, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00AD */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x3C, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00AE */
+    {0x00, 0x00, 0x00, 0x3C, 0x42, 0xBD, 0xA5, 0xB9, 0xA5, 0x42, 0x3C, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00AF */
+    {0x00, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00B0 */
+    {0x00, 0x00, 0x00, 0x18, 0x24, 0x24, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00B1 */
+    {0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0xFF, 0xFF, 0x18, 0x18, 0xFF, 0xFF,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00B2 */
+    {0x00, 0x00, 0x3C, 0x04, 0x08, 0x10, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00B3 */
+    {0x00, 0x00, 0x3C, 0x04, 0x18, 0x04, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00B4 */
+    {0x00, 0x00, 0x0C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00B5 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x7B,
+     0x60, 0x60, 0x60, 0x00},
+    /* U+00B6 */
+    {0x00, 0x00, 0x00, 0x7C, 0xF4, 0xF4, 0xF4, 0x74, 0x14, 0x14, 0x14, 0x14,
+     0x14, 0x00, 0x00, 0x00},
+    /* U+00B7 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00B8 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x10, 0x08, 0x38, 0x00},
+    /* U+00B9 */
+    {0x00, 0x00, 0x30, 0x10, 0x10, 0x10, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00BA */
+    {0x00, 0x00, 0x00, 0x1C, 0x22, 0x22, 0x22, 0x1C, 0x00, 0x3E, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00BB */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x6C, 0x36, 0x36, 0x6C, 0x48, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00BC */
+    {0x00, 0xC0, 0x40, 0x40, 0x40, 0xE0, 0x06, 0x38, 0xCC, 0x1C, 0x14, 0x3E,
+     0x04, 0x00, 0x00, 0x00},
+    /* U+00BD */
+    {0x00, 0xC0, 0x40, 0x40, 0x40, 0xE0, 0x06, 0x38, 0xDE, 0x02, 0x06, 0x08,
+     0x1E, 0x00, 0x00, 0x00},
+    /* U+00BE */
+    {0x00, 0x70, 0x08, 0x30, 0x08, 0x70, 0x06, 0x38, 0xCC, 0x1C, 0x14, 0x3E,
+     0x04, 0x00, 0x00, 0x00},
+    /* U+00BF */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x18, 0x18, 0x18, 0x30,
+     0x60, 0x64, 0x38, 0x00},
+    /* U+00C0 */
+    {0x30, 0x18, 0x00, 0x1C, 0x1C, 0x14, 0x36, 0x36, 0x3E, 0x36, 0x63, 0x63,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00C1 */
+    {0x0C, 0x18, 0x00, 0x1C, 0x1C, 0x14, 0x36, 0x36, 0x3E, 0x36, 0x63, 0x63,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00C2 */
+    {0x1C, 0x36, 0x00, 0x1C, 0x1C, 0x14, 0x36, 0x36, 0x3E, 0x36, 0x63, 0x63,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00C3 */
+    {0x3A, 0x2E, 0x00, 0x1C, 0x1C, 0x14, 0x36, 0x36, 0x3E, 0x36, 0x63, 0x63,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00C4 */
+    {0x36, 0x36, 0x00, 0x1C, 0x1C, 0x14, 0x36, 0x36, 0x3E, 0x36, 0x63, 0x63,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00C5 */
+    {0x08, 0x14, 0x14, 0x08, 0x1C, 0x1C, 0x14, 0x36, 0x3E, 0x36, 0x63, 0x63,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00C6 */
+    {0x00, 0x00, 0x00, 0x3E, 0x78, 0x78, 0x78, 0x7E, 0x78, 0xD8, 0xD8, 0xDE,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00C7 */
+    {0x00, 0x00, 0x00, 0x1E, 0x31, 0x60, 0x60, 0x60, 0x60, 0x60, 0x31, 0x1E,
+     0x08, 0x04, 0x18, 0x00},
+    /* U+00C8 */
+    {0x10, 0x08, 0x00, 0x7F, 0x60, 0x60, 0x60, 0x7E, 0x60, 0x60, 0x60, 0x7F,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00C9 */
+    {0x0C, 0x08, 0x00, 0x7F, 0x60, 0x60, 0x60, 0x7E, 0x60, 0x60, 0x60, 0x7F,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00CA */
+    {0x1C, 0x16, 0x00, 0x7F, 0x60, 0x60, 0x60, 0x7E, 0x60, 0x60, 0x60, 0x7F,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00CB */
+    {0x36, 0x36, 0x00, 0x7F, 0x60, 0x60, 0x60, 0x7E, 0x60, 0x60, 0x60, 0x7F,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00CC */
+    {0x30, 0x18, 0x00, 0x7E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x7E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00CD */
+    {0x0C, 0x18, 0x00, 0x7E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x7E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00CE */
+    {0x18, 0x24, 0x00, 0x7E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x7E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00CF */
+    {0x66, 0x66, 0x00, 0x7E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x7E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00D0 */
+    {0x00, 0x00, 0x00, 0x7C, 0x66, 0x63, 0xFB, 0x63, 0x63, 0x63, 0x66, 0x7C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00D1 */
+    {0x3A, 0x2E, 0x00, 0x73, 0x73, 0x73, 0x7B, 0x6B, 0x6F, 0x67, 0x67, 0x67,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00D2 */
+    {0x30, 0x18, 0x00, 0x1C, 0x36, 0x63, 0x63, 0x63, 0x63, 0x63, 0x36, 0x1C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00D3 */
+    {0x0C, 0x18, 0x00, 0x1C, 0x36, 0x63, 0x63, 0x63, 0x63, 0x63, 0x36, 0x1C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00D4 */
+    {0x1C, 0x36, 0x00, 0x1C, 0x36, 0x63, 0x63, 0x63, 0x63, 0x63, 0x36, 0x1C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00D5 */
+    {0x3A, 0x2E, 0x00, 0x1C, 0x36, 0x63, 0x63, 0x63, 0x63, 0x63, 0x36, 0x1C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00D6 */
+    {0x36, 0x36, 0x00, 0x1C, 0x36, 0x63, 0x63, 0x63, 0x63, 0x63, 0x36, 0x1C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00D7 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x24, 0x7E, 0x3C, 0x3C, 0x7E, 0x24, 0x00,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00D8 */
+    {0x00, 0x00, 0x00, 0x1F, 0x37, 0x67, 0x6F, 0x6B, 0x7B, 0x73, 0x76, 0xFC,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00D9 */
+    {0x30, 0x18, 0x00, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x3E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00DA */
+    {0x0C, 0x18, 0x00, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x3E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00DB */
+    {0x1C, 0x36, 0x00, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x3E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00DC */
+    {0x36, 0x36, 0x00, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x3E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00DD */
+    {0x0C, 0x18, 0x00, 0xC3, 0x66, 0x66, 0x3C, 0x3C, 0x18, 0x18, 0x18, 0x18,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00DE */
+    {0x00, 0x00, 0x00, 0x60, 0x60, 0x7E, 0x63, 0x63, 0x63, 0x63, 0x7E, 0x60,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00DF */
+    {0x00, 0x3C, 0x62, 0x66, 0x6C, 0x6C, 0x6C, 0x6C, 0x66, 0x66, 0x66, 0x6C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00E0 */
+    {0x00, 0x00, 0x30, 0x18, 0x00, 0x1C, 0x26, 0x06, 0x3E, 0x66, 0x66, 0x3E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00E1 */
+    {0x00, 0x00, 0x0C, 0x18, 0x00, 0x1C, 0x26, 0x06, 0x3E, 0x66, 0x66, 0x3E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00E2 */
+    {0x00, 0x00, 0x1C, 0x36, 0x00, 0x1C, 0x26, 0x06, 0x3E, 0x66, 0x66, 0x3E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00E3 */
+    {0x00, 0x00, 0x34, 0x2C, 0x00, 0x1C, 0x26, 0x06, 0x3E, 0x66, 0x66, 0x3E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00E4 */
+    {0x00, 0x00, 0x36, 0x36, 0x00, 0x1C, 0x26, 0x06, 0x3E, 0x66, 0x66, 0x3E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00E5 */
+    {0x18, 0x24, 0x24, 0x18, 0x00, 0x1C, 0x26, 0x06, 0x3E, 0x66, 0x66, 0x3E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00E6 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x5A, 0x1A, 0x7E, 0xD8, 0xD8, 0x7E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00E7 */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x32, 0x60, 0x60, 0x60, 0x32, 0x1C,
+     0x08, 0x08, 0x38, 0x00},
+    /* U+00E8 */
+    {0x00, 0x00, 0x30, 0x18, 0x00, 0x3C, 0x66, 0x66, 0x7E, 0x60, 0x62, 0x3C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00E9 */
+    {0x00, 0x00, 0x06, 0x08, 0x00, 0x3C, 0x66, 0x66, 0x7E, 0x60, 0x62, 0x3C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00EA */
+    {0x00, 0x00, 0x0C, 0x12, 0x00, 0x3C, 0x66, 0x66, 0x7E, 0x60, 0x62, 0x3C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00EB */
+    {0x00, 0x00, 0x36, 0x36, 0x00, 0x3C, 0x66, 0x66, 0x7E, 0x60, 0x62, 0x3C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00EC */
+    {0x00, 0x00, 0x30, 0x18, 0x00, 0x78, 0x18, 0x18, 0x18, 0x18, 0x18, 0x7E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00ED */
+    {0x00, 0x00, 0x0C, 0x18, 0x00, 0x78, 0x18, 0x18, 0x18, 0x18, 0x18, 0x7E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00EE */
+    {0x00, 0x00, 0x1C, 0x36, 0x00, 0x78, 0x18, 0x18, 0x18, 0x18, 0x18, 0x7E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00EF */
+    {0x00, 0x00, 0x36, 0x36, 0x00, 0x78, 0x18, 0x18, 0x18, 0x18, 0x18, 0x7E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00F0 */
+    {0x00, 0x34, 0x18, 0x38, 0x0C, 0x3C, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00F1 */
+    {0x00, 0x00, 0x34, 0x2C, 0x00, 0x7C, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00F2 */
+    {0x00, 0x00, 0x20, 0x10, 0x00, 0x3C, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00F3 */
+    {0x00, 0x00, 0x04, 0x08, 0x00, 0x3C, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00F4 */
+    {0x00, 0x00, 0x18, 0x24, 0x00, 0x3C, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00F5 */
+    {0x00, 0x00, 0x34, 0x2C, 0x00, 0x3C, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00F6 */
+    {0x00, 0x00, 0x66, 0x66, 0x00, 0x3C, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3C,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00F7 */
+    {0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0xFF, 0xFF, 0x00, 0x18, 0x18,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00F8 */
+    {0x00, 0x00, 0x00, 0x00, 0x02, 0x3E, 0x6E, 0x6E, 0x7E, 0x76, 0x66, 0x7C,
+     0x40, 0x00, 0x00, 0x00},
+    /* U+00F9 */
+    {0x00, 0x00, 0x30, 0x18, 0x00, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00FA */
+    {0x00, 0x00, 0x0C, 0x18, 0x00, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00FB */
+    {0x00, 0x00, 0x18, 0x24, 0x00, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00FC */
+    {0x00, 0x00, 0x66, 0x66, 0x00, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3E,
+     0x00, 0x00, 0x00, 0x00},
+    /* U+00FD */
+    {0x00, 0x00, 0x0C, 0x18, 0x00, 0x66, 0x66, 0x2C, 0x3C, 0x3C, 0x18, 0x18,
+     0x18, 0x30, 0x70, 0x00},
+    /* U+00FE */
+    {0x00, 0x60, 0x60, 0x60, 0x60, 0x7C, 0x66, 0x66, 0x66, 0x66, 0x66, 0x7C,
+     0x60, 0x60, 0x60, 0x00},
+    /* U+00FF */
+    {0x00, 0x00, 0x66, 0x66, 0x00, 0x66, 0x66, 0x2C, 0x3C, 0x3C, 0x18, 0x18,
+     0x18, 0x30, 0x70, 0x00},
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+/* A block device, identified like the kernel does in uevents. */
+struct blockdev {
+  /* Kernel name (DEVNAME without /dev/ prefix), e.g. "sdb1" */
+  char *name;
+  dev_t devnum;
+  /* devpaths (as in uevents, i.e. relative to /sys) of the block device, of
+   * all devices it is stacked on and of all of their parents. The removal of
+   * any of them means the block device is gone. */
+  char **devpaths;
+  int num_devpaths;
+};
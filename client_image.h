@@ -0,0 +1,18 @@
+#pragma once
+
+/* An image in the X server's ZPixmap format for a given depth, rendered on the
+ * client side and sent to the server with upload_image(). If possible, data
+ * lives in a MIT-SHM segment the server has attached as shmseg (otherwise 0),
+ * so that uploading it does not go through the X11 connection. */
+struct client_image {
+  uint8_t *data;
+  uint16_t width;
+  uint16_t height;
+  uint8_t depth;
+  uint8_t bytes_per_pixel;
+  /* The server's image byte order */
+  bool lsb_first;
+  /* Bytes per row, including the server's scanline padding */
+  uint32_t stride;
+  uint32_t shmseg;
+};
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdbool.h>
+#include <xcb/xcb.h>
+
+#include "message_layout.h"
+#include "copy_message_tiles.h"
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+
+static bool contains(const xcb_rectangle_t *outer,
+                     const xcb_rectangle_t *inner) {
+  return inner->x >= outer->x && inner->y >= outer->y &&
+         inner->x + inner->width <= outer->x + outer->width &&
+         inner->y + inner->height <= outer->y + outer->height;
+}
+
+/*
+ * Adds rect to damage. Rectangles which are already covered are dropped. Once
+ * MAX_DAMAGE_RECTS are in use, rect is merged into the bounding box of the
+ * last one, so that any burst of exposes fits.
+ *
+ */
+void damage_add(struct damage *damage, const xcb_rectangle_t *rect) {
+  for (int i = 0; i < damage->num_rects; i++) {
+    if (contains(&(damage->rects[i]), rect)) {
+      return;
+    }
+  }
+  if (damage->num_rects < MAX_DAMAGE_RECTS) {
+    damage->rects[damage->num_rects++] = *rect;
+    return;
+  }
+  xcb_rectangle_t *last = &(damage->rects[MAX_DAMAGE_RECTS - 1]);
+  const int x1 = MIN(last->x, rect->x);
+  const int y1 = MIN(last->y, rect->y);
+  const int x2 = MAX(last->x + last->width, rect->x + rect->width);
+  const int y2 = MAX(last->y + last->height, rect->y + rect->height);
+  *last = (xcb_rectangle_t){x1, y1, x2 - x1, y2 - y1};
+}
+
+/* Returns the largest value <= pos of the grid origin + k * step. */
+static int grid_floor(int pos, int origin, int step) {
+  int offset = (pos - origin) % step;
+  if (offset < 0) {
+    offset += step;
+  }
+  return pos - offset;
+}
+
+/*
+ * Copies the parts of the message tiles which intersect area from the message
+ * pixmap to the real window. Tiles are clipped to their output, so that no
+ * message is split across monitors. Does not flush the connection.
+ *
+ */
+void copy_message_tiles_area(xcb_connection_t *conn, xcb_pixmap_t pixmap,
+                             xcb_window_t window, xcb_gcontext_t pixmap_gc,
+                             const xcb_rectangle_t *area,
+                             const struct message_layout *layout) {
+  const int mw = layout->message_width;
+  const int mh = layout->message_height;
+  for (int i = 0; i < layout->num_outputs; i++) {
+    const xcb_rectangle_t *output = &(layout->outputs[i]);
+    const int x1 = MAX(area->x, output->x);
+    const int y1 = MAX(area->y, output->y);
+    const int x2 = MIN(area->x + area->width, output->x + output->width);
+    const int y2 = MIN(area->y + area->height, output->y + output->height);
+    if (x1 >= x2 || y1 >= y2) {
+      continue;
+    }
+    /* One tile sits in the center of the output. */
+    const int origin_x = output->x + (output->width - mw) / 2;
+    const int origin_y = output->y + (output->height - mh) / 2;
+    for (int y = grid_floor(y1, origin_y, mh); y < y2; y += mh) {
+      for (int x = grid_floor(x1, origin_x, mw); x < x2; x += mw) {
+        const int from_x = MAX(x, x1);
+        const int from_y = MAX(y, y1);
+        const int to_x = MIN(x + mw, x2);
+        const int to_y = MIN(y + mh, y2);
+        xcb_copy_area(conn, pixmap, window, pixmap_gc, from_x - x, from_y - y,
+                      from_x, from_y, to_x - from_x, to_y - from_y);
+      }
+    }
+  }
+}
+
+/*
+ * Copies the message tiles for all damaged areas and resets damage. Does not
+ * flush the connection.
+ *
+ */
+void copy_message_tiles_damaged(xcb_connection_t *conn, xcb_pixmap_t pixmap,
+                                xcb_window_t window, xcb_gcontext_t pixmap_gc,
+                                struct damage *damage,
+                                const struct message_layout *layout) {
+  for (int i = 0; i < damage->num_rects; i++) {
+    copy_message_tiles_area(conn, pixmap, window, pixmap_gc,
+                            &(damage->rects[i]), layout);
+  }
+  damage->num_rects = 0;
+}
+
+/*
+ * Copies the contents of the message pixmap to the real window, covering all
+ * outputs. Does not flush the connection.
+ *
+ */
+void copy_message_tiles(xcb_connection_t *conn, xcb_pixmap_t pixmap,
+                        xcb_window_t window, xcb_gcontext_t pixmap_gc,
+                        const struct message_layout *layout) {
+  for (int i = 0; i < layout->num_outputs; i++) {
+    copy_message_tiles_area(conn, pixmap, window, pixmap_gc,
+                            &(layout->outputs[i]), layout);
+  }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+/* Maximum number of rectangles kept apart in struct damage */
+#define MAX_DAMAGE_RECTS 16
+
+/* Areas of the window which need to be repainted. */
+struct damage {
+  xcb_rectangle_t rects[MAX_DAMAGE_RECTS];
+  int num_rects;
+};
+
+void damage_add(struct damage *damage, const xcb_rectangle_t *rect);
+void copy_message_tiles_area(xcb_connection_t *conn, xcb_pixmap_t pixmap,
+                             xcb_window_t window, xcb_gcontext_t pixmap_gc,
+                             const xcb_rectangle_t *area,
+                             const struct message_layout *layout);
+void copy_message_tiles_damaged(xcb_connection_t *conn, xcb_pixmap_t pixmap,
+                                xcb_window_t window, xcb_gcontext_t pixmap_gc,
+                                struct damage *damage,
+                                const struct message_layout *layout);
+void copy_message_tiles(xcb_connection_t *conn, xcb_pixmap_t pixmap,
+                        xcb_window_t window, xcb_gcontext_t pixmap_gc,
+                        const struct message_layout *layout);
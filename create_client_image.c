@@ -0,0 +1,143 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <err.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <xcb/xcb.h>
+#include <xcb/shm.h>
+
+#include "client_image.h"
+#include "create_client_image.h"
+
+/*
+ * Allocates size bytes of shared memory for image and lets the X server attach
+ * it. Returns false if the server does not support MIT-SHM or cannot attach
+ * the segment (e.g. because it runs on a different machine).
+ *
+ */
+static bool attach_shm(xcb_connection_t *conn, struct client_image *image,
+                       size_t size) {
+  const xcb_query_extension_reply_t *extension =
+      xcb_get_extension_data(conn, &xcb_shm_id);
+  if (extension == NULL || !extension->present) {
+    return false;
+  }
+
+  const int shmid = shmget(IPC_PRIVATE, size, IPC_CREAT | 0600);
+  if (shmid == -1) {
+    warn("shmget(%zu)", size);
+    return false;
+  }
+  void *data = shmat(shmid, NULL, 0);
+  if (data == (void *)-1) {
+    warn("shmat");
+    shmctl(shmid, IPC_RMID, NULL);
+    return false;
+  }
+  const xcb_shm_seg_t shmseg = xcb_generate_id(conn);
+  xcb_generic_error_t *error = xcb_request_check(
+      conn, xcb_shm_attach_checked(conn, shmseg, shmid, 1 /* read-only */));
+  /* The segment goes away once both the server and we have detached it. */
+  shmctl(shmid, IPC_RMID, NULL);
+  if (error != NULL) {
+    free(error);
+    shmdt(data);
+    return false;
+  }
+  image->data = data;
+  image->shmseg = shmseg;
+  return true;
+}
+
+/*
+ * Allocates an image of width x height pixels in the ZPixmap format the X
+ * server uses for depth. Returns false if there is no such format or it has
+ * less than 8 bits per pixel, which this code does not render.
+ *
+ */
+bool create_client_image(xcb_connection_t *conn, uint8_t depth, uint16_t width,
+                         uint16_t height, struct client_image *image) {
+  const xcb_setup_t *setup = xcb_get_setup(conn);
+  const xcb_format_t *format = NULL;
+  for (xcb_format_iterator_t it = xcb_setup_pixmap_formats_iterator(setup);
+       it.rem > 0; xcb_format_next(&it)) {
+    if (it.data->depth == depth) {
+      format = it.data;
+      break;
+    }
+  }
+  if (format == NULL || format->bits_per_pixel < 8 ||
+      format->bits_per_pixel % 8 != 0) {
+    return false;
+  }
+
+  image->width = width;
+  image->height = height;
+  image->depth = depth;
+  image->bytes_per_pixel = format->bits_per_pixel / 8;
+  image->lsb_first = (setup->image_byte_order == XCB_IMAGE_ORDER_LSB_FIRST);
+  const uint32_t pad = format->scanline_pad / 8;
+  image->stride = (width * image->bytes_per_pixel + pad - 1) / pad * pad;
+  image->shmseg = 0;
+  if (!attach_shm(conn, image, (size_t)height * image->stride) &&
+      (image->data = calloc(height, image->stride)) == NULL) {
+    err(EXIT_FAILURE, "calloc(%d, %d)", height, image->stride);
+  }
+  return true;
+}
+
+void destroy_client_image(xcb_connection_t *conn, struct client_image *image) {
+  if (image->shmseg != 0) {
+    xcb_shm_detach(conn, image->shmseg);
+    shmdt(image->data);
+  } else {
+    free(image->data);
+  }
+  image->data = NULL;
+}
+
+/*
+ * Sets the pixels of the given rectangle (clipped to the image) to pixel, a
+ * value as returned by get_colorpixel().
+ *
+ */
+void fill_client_image(struct client_image *image, int x, int y, int width,
+                       int height, uint32_t pixel) {
+  const int x1 = (x < 0 ? 0 : x);
+  const int y1 = (y < 0 ? 0 : y);
+  const int x2 = (x + width > image->width ? image->width : x + width);
+  const int y2 = (y + height > image->height ? image->height : y + height);
+  if (x1 >= x2 || y1 >= y2) {
+    return;
+  }
+
+  /* Fill the first row pixel by pixel, then copy it to the others. */
+  const int bpp = image->bytes_per_pixel;
+  uint8_t *first = image->data + y1 * image->stride + x1 * bpp;
+  for (int i = 0; i < x2 - x1; i++) {
+    for (int b = 0; b < bpp; b++) {
+      first[i * bpp + (image->lsb_first ? b : bpp - 1 - b)] = pixel >> (8 * b);
+    }
+  }
+  for (int row = y1 + 1; row < y2; row++) {
+    memcpy(image->data + row * image->stride + x1 * bpp, first,
+           (x2 - x1) * bpp);
+  }
+}
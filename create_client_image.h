@@ -0,0 +1,7 @@
+#pragma once
+
+bool create_client_image(xcb_connection_t *conn, uint8_t depth, uint16_t width,
+                         uint16_t height, struct client_image *image);
+void fill_client_image(struct client_image *image, int x, int y, int width,
+                       int height, uint32_t pixel);
+void destroy_client_image(xcb_connection_t *conn, struct client_image *image);
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <xcb/xcb.h>
+
+#include "bitmap_font.h"
+#include "client_image.h"
+#include "create_client_image.h"
+#include "text_layout.h"
+#include "draw_bitmap_text.h"
+
+/*
+ * Renders text (laid out for an advance of BITMAP_FONT_WIDTH * scale pixels)
+ * into image with the compiled-in font, each font pixel becoming a square of
+ * scale x scale pixels. Like draw_text_layout(), (x, y) is where the top of
+ * the text goes. Only the foreground is drawn.
+ *
+ */
+void draw_bitmap_text(struct client_image *image,
+                      const struct text_layout *text, int scale, int16_t x,
+                      int16_t y, uint32_t foreground) {
+  for (int r = 0; r < text->num_runs; r++) {
+    const struct text_run *run = &text->runs[r];
+    const int top = y + run->y - BITMAP_FONT_ASCENT * scale;
+    for (int i = 0; i < run->len; i++) {
+      const uint8_t *glyph = bitmap_font_glyph(text->chars[run->offset + i]);
+      const int left = x + i * BITMAP_FONT_WIDTH * scale;
+      for (int row = 0; row < BITMAP_FONT_HEIGHT; row++) {
+        for (int col = 0; col < BITMAP_FONT_WIDTH; col++) {
+          if (glyph[row] & (0x80 >> col)) {
+            fill_client_image(image, left + col * scale, top + row * scale,
+                              scale, scale, foreground);
+          }
+        }
+      }
+    }
+  }
+}
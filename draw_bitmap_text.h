@@ -0,0 +1,5 @@
+#pragma once
+
+void draw_bitmap_text(struct client_image *image,
+                      const struct text_layout *text, int scale, int16_t x,
+                      int16_t y, uint32_t foreground);
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <err.h>
+#include <xcb/xcb.h>
+#include <xcb/xcbext.h>
+
+#include "monotonic_ms.h"
+#include "grab_keyboard.h"
+
+/* The first retry happens after this many milliseconds, every further retry
+ * waits twice as long, up to GRAB_MAX_BACKOFF_MS. */
+#define GRAB_INITIAL_BACKOFF_MS 1
+#define GRAB_MAX_BACKOFF_MS 64
+/* Give up grabbing the keyboard after this many milliseconds. */
+#define GRAB_TIMEOUT_MS 2000
+
+static void send_grab(xcb_connection_t *conn, struct keyboard_grab *grab) {
+  grab->cookie = xcb_grab_keyboard(conn, true, grab->root, XCB_CURRENT_TIME,
+                                   XCB_GRAB_MODE_ASYNC, XCB_GRAB_MODE_ASYNC);
+  xcb_flush(conn);
+  grab->attempts++;
+  grab->state = KEYBOARD_GRAB_IN_FLIGHT;
+}
+
+/*
+ * Sends the first GrabKeyboard request without waiting for its reply. The
+ * reply is picked up by grab_keyboard_process(), which must be called
+ * whenever the X11 connection was readable or grab_keyboard_deadline_ms()
+ * (see monotonic_ms()) passed. This way, no round-trip to the X server blocks
+ * the removal path.
+ *
+ */
+void grab_keyboard_start(xcb_connection_t *conn, xcb_window_t root,
+                         struct keyboard_grab *grab) {
+  grab->root = root;
+  grab->attempts = 0;
+  grab->backoff_ms = GRAB_INITIAL_BACKOFF_MS;
+  grab->started_ms = monotonic_ms();
+  send_grab(conn, grab);
+}
+
+static void finish(struct keyboard_grab *grab, enum keyboard_grab_state state) {
+  grab->state = state;
+  printf("%s keyboard after %d round-trips (%lld ms), none of them blocking\n",
+         (state == KEYBOARD_GRAB_SUCCESS ? "Grabbed" : "Could not grab"),
+         grab->attempts, (long long)(monotonic_ms() - grab->started_ms));
+}
+
+void grab_keyboard_process(xcb_connection_t *conn, struct keyboard_grab *grab) {
+  const int64_t now = monotonic_ms();
+  if (grab->state == KEYBOARD_GRAB_BACKOFF && now >= grab->next_attempt_ms) {
+    send_grab(conn, grab);
+    return;
+  }
+  if (grab->state != KEYBOARD_GRAB_IN_FLIGHT) {
+    return;
+  }
+
+  void *reply = NULL;
+  xcb_generic_error_t *error = NULL;
+  if (!xcb_poll_for_reply(conn, grab->cookie.sequence, &reply, &error)) {
+    /* Not yet received */
+    return;
+  }
+  const bool grabbed =
+      (reply != NULL && ((xcb_grab_keyboard_reply_t *)reply)->status ==
+                            XCB_GRAB_STATUS_SUCCESS);
+  free(reply);
+  free(error);
+  if (grabbed) {
+    finish(grab, KEYBOARD_GRAB_SUCCESS);
+  } else if (now - grab->started_ms >= GRAB_TIMEOUT_MS) {
+    finish(grab, KEYBOARD_GRAB_FAILED);
+  } else {
+    /* Most likely, another client still holds a grab. */
+    grab->state = KEYBOARD_GRAB_BACKOFF;
+    grab->next_attempt_ms = now + grab->backoff_ms;
+    if ((grab->backoff_ms *= 2) > GRAB_MAX_BACKOFF_MS) {
+      grab->backoff_ms = GRAB_MAX_BACKOFF_MS;
+    }
+  }
+}
+
+/*
+ * Returns the number of milliseconds until grab_keyboard_process() needs to be
+ * called even if the X11 connection is not readable, or -1.
+ *
+ */
+int64_t grab_keyboard_deadline_ms(const struct keyboard_grab *grab) {
+  return (grab->state == KEYBOARD_GRAB_BACKOFF ? grab->next_attempt_ms : -1);
+}
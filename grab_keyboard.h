@@ -0,0 +1,26 @@
+#pragma once
+
+enum keyboard_grab_state {
+  /* A GrabKeyboard request is in flight */
+  KEYBOARD_GRAB_IN_FLIGHT,
+  /* Waiting for the next attempt */
+  KEYBOARD_GRAB_BACKOFF,
+  KEYBOARD_GRAB_SUCCESS,
+  KEYBOARD_GRAB_FAILED,
+};
+
+/* Asynchronous attempts to grab the keyboard, see grab_keyboard_start(). */
+struct keyboard_grab {
+  enum keyboard_grab_state state;
+  xcb_window_t root;
+  xcb_grab_keyboard_cookie_t cookie;
+  int attempts;
+  int backoff_ms;
+  int64_t started_ms;
+  int64_t next_attempt_ms;
+};
+
+void grab_keyboard_start(xcb_connection_t *conn, xcb_window_t root,
+                         struct keyboard_grab *grab);
+void grab_keyboard_process(xcb_connection_t *conn, struct keyboard_grab *grab);
+int64_t grab_keyboard_deadline_ms(const struct keyboard_grab *grab);
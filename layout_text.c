@@ -0,0 +1,160 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <err.h>
+#include <xcb/xcb.h>
+
+#include "utf8_to_ucs2.h"
+#include "text_layout.h"
+#include "layout_text.h"
+
+/* xcb_image_text_16() draws at most 255 characters per request. */
+#define MAX_RUN_LEN 255
+
+struct word {
+  uint16_t offset;
+  uint16_t len;
+  /* Which of the strings the word belongs to */
+  int string;
+  xcb_query_text_extents_cookie_t cookie;
+  int32_t width;
+};
+
+static bool is_space(const xcb_char2b_t *c) {
+  return (c->byte1 == 0 && c->byte2 == ' ');
+}
+
+static int32_t text_width(xcb_connection_t *conn,
+                          xcb_query_text_extents_cookie_t cookie) {
+  xcb_query_text_extents_reply_t *reply =
+      xcb_query_text_extents_reply(conn, cookie, NULL);
+  if (reply == NULL) {
+    errx(EXIT_FAILURE, "Could not query text extents");
+  }
+  const int32_t width = reply->overall_width;
+  free(reply);
+  return width;
+}
+
+/*
+ * Converts the strings to UCS-2 and word-wraps them to max_width pixels, each
+ * string starting on a new line. The width of every word is queried from the
+ * X server with one QueryTextExtents request; all of them are sent before the
+ * first reply is read, so this costs a single round-trip. If advance is not 0,
+ * every character is advance pixels wide instead (the compiled-in font, see
+ * draw_bitmap_text()) and the X server is not involved at all. Lines are
+ * font_height + line_spacing pixels apart.
+ *
+ * The result is a fixed-size array of lines which draw_text_layout() turns into
+ * one ImageText16 request each, without converting or allocating anything.
+ *
+ */
+void layout_text(xcb_connection_t *conn, xcb_font_t font, int advance,
+                 int font_height, int line_spacing,
+                 const char *const strings[], int num_strings, int max_width,
+                 struct text_layout *layout) {
+  static struct word words[MAX_TEXT_WORDS];
+  int num_words = 0;
+
+  layout->num_chars = 0;
+  for (int s = 0; s < num_strings; s++) {
+    const int available = MAX_TEXT_CHARS - layout->num_chars;
+    xcb_char2b_t *chars = &layout->chars[layout->num_chars];
+    int len = utf8_to_ucs2(strings[s], chars, available);
+    if (len > available) {
+      warnx("Message text exceeds %d characters, truncating", MAX_TEXT_CHARS);
+      len = available;
+    }
+
+    for (int i = 0; i < len;) {
+      if (is_space(&chars[i])) {
+        i++;
+        continue;
+      }
+      int end = i;
+      while (end < len && !is_space(&chars[end]) && end - i < MAX_RUN_LEN) {
+        end++;
+      }
+      if (num_words == MAX_TEXT_WORDS) {
+        warnx("Message text exceeds %d words, truncating", MAX_TEXT_WORDS);
+        break;
+      }
+      struct word *word = &words[num_words++];
+      *word = (struct word){
+          .offset = layout->num_chars + i,
+          .len = end - i,
+          .string = s,
+          .width = (end - i) * advance,
+      };
+      if (advance == 0) {
+        word->cookie = xcb_query_text_extents(conn, font, end - i, &chars[i]);
+      }
+      i = end;
+    }
+    layout->num_chars += len;
+  }
+
+  int32_t space_width = advance;
+  if (advance == 0) {
+    const xcb_char2b_t space = {.byte1 = 0, .byte2 = ' '};
+    space_width =
+        text_width(conn, xcb_query_text_extents(conn, font, 1, &space));
+    for (int w = 0; w < num_words; w++) {
+      words[w].width = text_width(conn, words[w].cookie);
+    }
+  }
+
+  /* Greedily put as many words on each line as fit. A word which is wider
+   * than max_width on its own gets a line of its own. */
+  layout->num_runs = 0;
+  int32_t line_width = 0;
+  struct text_run *run = NULL;
+  for (int w = 0; w < num_words; w++) {
+    const struct word *word = &words[w];
+    const bool fits = (run != NULL && words[w - 1].string == word->string &&
+                       line_width + space_width + word->width <= max_width &&
+                       word->offset + word->len - run->offset <= MAX_RUN_LEN);
+    if (fits) {
+      run->len = word->offset + word->len - run->offset;
+      line_width += space_width + word->width;
+      continue;
+    }
+    if (layout->num_runs == MAX_TEXT_RUNS) {
+      warnx("Message text exceeds %d lines, truncating", MAX_TEXT_RUNS);
+      break;
+    }
+    run = &layout->runs[layout->num_runs++];
+    *run = (struct text_run){
+        .offset = word->offset,
+        .len = word->len,
+        .y = layout->num_runs * (font_height + line_spacing),
+    };
+    line_width = word->width;
+  }
+  layout->height = layout->num_runs * (font_height + line_spacing);
+}
+
+void draw_text_layout(xcb_connection_t *conn, xcb_drawable_t drawable,
+                      xcb_gcontext_t gc, const struct text_layout *layout,
+                      int16_t x, int16_t y) {
+  for (int i = 0; i < layout->num_runs; i++) {
+    const struct text_run *run = &layout->runs[i];
+    xcb_image_text_16(conn, run->len, drawable, gc, x, y + run->y,
+                      &layout->chars[run->offset]);
+  }
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+void layout_text(xcb_connection_t *conn, xcb_font_t font, int advance,
+                 int font_height, int line_spacing,
+                 const char *const strings[], int num_strings, int max_width,
+                 struct text_layout *layout);
+void draw_text_layout(xcb_connection_t *conn, xcb_drawable_t drawable,
+                      xcb_gcontext_t gc, const struct text_layout *layout,
+                      int16_t x, int16_t y);
@@ -19,24 +19,41 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
 #include <err.h>
 #include <xcb/xcb.h>
 #include <xcb/xcb_aux.h>
 #include <locale.h>
 #include <errno.h>
-#include <sys/time.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <sys/types.h>
+#include <sys/sysmacros.h>
 
 #include "gettext.h"
 
+#include "blockdev.h"
+#include "watchset.h"
 #include "open_fullscreen_window.h"
 #include "mountpoint_to_blockdev.h"
+#include "resolve_blockdev_ancestry.h"
 #include "wait_for_blockdev_removal.h"
+#include "probe_liveness.h"
 #include "reboot.h"
 #include "mlock.h"
+#include "reexec_memfd.h"
 #include "get_colorpixel.h"
 #include "open_font.h"
 #include "utf8_to_ucs2.h"
+#include "message_layout.h"
 #include "prepare_message_window.h"
+#include "copy_message_tiles.h"
+#include "monotonic_ms.h"
+#include "grab_keyboard.h"
+#include "stats.h"
 
 void usage(void) {
   printf("root-vanished [options]\n");
@@ -47,39 +64,119 @@ void usage(void) {
   printf("\n");
   printf("Options:\n");
   printf("\t--mountpoint\tMountpoint to resolve into a block device to watch. "
-         "(default: \"/\")\n");
+         "Can be specified multiple times. (default: \"/\")\n");
   printf("\t--reboot\tInitiate a reboot once the user pressed a key. (default: "
          "false)\n");
   printf("\t--reboot_fallback_seconds\tIn case the keyboard cannot be grabbed, "
          "automatically reboot after this many seconds. (default: -1)\n");
+  printf("\t--reboot_methods\tComma-separated list of ways to reboot, tried "
+         "in order until one works: \"logind\", \"syscall\" (reboot(2)), "
+         "\"sysrq\" (sync, remount read-only and reboot via "
+         "/proc/sysrq-trigger). (default: \"logind,syscall,sysrq\")\n");
+  printf("\t--reboot_logind_timeout_ms\tGive up on logind if it does not "
+         "answer within this many milliseconds. (default: 5000)\n");
+  printf("\t--reexec_memfd\tCopy the executable into memory and re-execute "
+         "it from there. (default: false)\n");
+  printf("\t--builtin_font\tRender the message with the compiled-in font "
+         "instead of the X server's fixed font, which is also used if the "
+         "latter is not installed. (default: false)\n");
+  printf("\t--probe_interval_ms\tIn addition to waiting for uevents, check "
+         "sysfs for the block devices this often, in case their removal "
+         "goes unannounced. This is the only periodic wakeup while idle; "
+         "0 disables the check. (default: 0)\n");
+  printf("\t--mlock_pages\tOnly mlock() the pages listed in this file, as "
+         "written by --mlock_record. Cannot be combined with --mlock_mode=all. "
+         "(default: lock all mapped files)\n");
+  printf("\t--mlock_mode\tHow to keep the program in memory: \"files\" "
+         "mlock()s all mapped files, \"onfault\" locks their pages once they "
+         "are used, \"all\" uses mlockall(). (default: \"files\", \"all\" "
+         "for the static binary with --reexec_memfd unless --mlock_pages is "
+         "given)\n");
+  printf("\t--mlock_record\tRehearse the removal of the block device, write "
+         "the pages it needed to this file and exit.\n");
+  printf("\t--stats\tPrint wakeups, uevents, memory usage and the duration "
+         "of each startup stage on SIGUSR1 and on exit. (default: false)\n");
+  printf("\t--trace\tWrite the timings of the startup stages to this file "
+         "in Chrome's trace event format (for chrome://tracing or "
+         "Perfetto).\n");
+}
+
+static void epoll_add(int epoll_fd, int fd) {
+  struct epoll_event ev = {.events = EPOLLIN, .data.fd = fd};
+  if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) == -1)
+    err(EXIT_FAILURE, "epoll_ctl");
+}
+
+/*
+ * Arms timer_fd to expire at deadline_ms on the CLOCK_MONOTONIC scale (as
+ * returned by monotonic_ms()), or disarms it if deadline_ms is -1.
+ *
+ */
+static void timer_arm(int timer_fd, int64_t deadline_ms) {
+  struct itimerspec its = {{0, 0}, {0, 0}};
+  if (deadline_ms != -1) {
+    its.it_value.tv_sec = deadline_ms / 1000;
+    its.it_value.tv_nsec = (deadline_ms % 1000) * 1000000;
+    /* An all-zero it_value would disarm the timer instead. */
+    if (its.it_value.tv_sec == 0 && its.it_value.tv_nsec == 0)
+      its.it_value.tv_nsec = 1;
+  }
+  if (timerfd_settime(timer_fd, TFD_TIMER_ABSTIME, &its, NULL) == -1)
+    err(EXIT_FAILURE, "timerfd_settime");
 }
 
 int main(int argc, char *argv[]) {
   bool reboot_when_removed = false;
-  char *mountpoint = "/";
+  bool reexec_memfd = false;
+  bool builtin_font = false;
+  char **mountpoints = NULL;
+  int num_mountpoints = 0;
   int option_index = 0;
   int opt;
   int reboot_fallback_seconds = -1;
+  char *reboot_methods = "logind,syscall,sysrq";
+  int reboot_logind_timeout_ms = 5000;
+  char *mlock_pages = NULL;
+  int mlock_mode = -1;
+  char *mlock_record_path = NULL;
+  int probe_interval_ms = 0;
+  bool print_stats = false;
+  char *trace_path = NULL;
   const struct option options[] = {
       {"mountpoint", required_argument, NULL, 'm'},
       {"reboot", no_argument, NULL, 'r'},
       {"reboot_fallback_seconds", required_argument, NULL, 'f'},
+      {"reboot_methods", required_argument, NULL, 'M'},
+      {"reboot_logind_timeout_ms", required_argument, NULL, 'T'},
+      {"reexec_memfd", no_argument, NULL, 'x'},
+      {"builtin_font", no_argument, NULL, 'b'},
+      {"probe_interval_ms", required_argument, NULL, 'P'},
+      {"mlock_pages", required_argument, NULL, 'p'},
+      {"mlock_mode", required_argument, NULL, 'l'},
+      {"mlock_record", required_argument, NULL, 'R'},
+      {"stats", no_argument, NULL, 'S'},
+      {"trace", required_argument, NULL, 't'},
       {"version", no_argument, NULL, 'v'},
       {"help", no_argument, NULL, 'h'},
       {0, 0, 0, 0},
   };
 
+  int stage = stats_stage_begin("locale");
   setlocale(LC_ALL, "");
   bindtextdomain("root-vanished", LOCALEDIR);
   if (bind_textdomain_codeset("root-vanished", "UTF-8") == NULL) {
     err(EXIT_FAILURE, "bind_textdomain_codeset(root-vanished, UTF-8)");
   }
   textdomain("root-vanished");
+  stats_stage_end(stage);
 
   while ((opt = getopt_long(argc, argv, "vh", options, &option_index)) != -1) {
     switch (opt) {
     case 'm':
-      if ((mountpoint = strdup(optarg)) == NULL)
+      if ((mountpoints = realloc(mountpoints, (num_mountpoints + 1) *
+                                                  sizeof(char *))) == NULL)
+        err(EXIT_FAILURE, "realloc");
+      if ((mountpoints[num_mountpoints++] = strdup(optarg)) == NULL)
         err(EXIT_FAILURE, "strdup");
       break;
 
@@ -102,6 +199,91 @@ int main(int argc, char *argv[]) {
       reboot_fallback_seconds = (int)val;
       break;
 
+    case 'M':
+      if ((reboot_methods = strdup(optarg)) == NULL)
+        err(EXIT_FAILURE, "strdup");
+      break;
+
+    case 'T': {
+      errno = 0;
+      char *end = NULL;
+      const long int val = strtol(optarg, &end, 0);
+      if (errno != 0) {
+        err(EXIT_FAILURE, "strtol(\"%s\")", optarg);
+      }
+      if (*end != '\0') {
+        errx(EXIT_FAILURE,
+             "Could not convert --reboot_logind_timeout_ms (\"%s\") to "
+             "integer",
+             optarg);
+      }
+      if (val < 0 || val > INT_MAX) {
+        errx(EXIT_FAILURE,
+             "--reboot_logind_timeout_ms must be between 0 and %d", INT_MAX);
+      }
+      reboot_logind_timeout_ms = (int)val;
+      break;
+    }
+
+    case 'x':
+      reexec_memfd = true;
+      break;
+
+    case 'b':
+      builtin_font = true;
+      break;
+
+    case 'P': {
+      errno = 0;
+      char *end = NULL;
+      const long int val = strtol(optarg, &end, 0);
+      if (errno != 0) {
+        err(EXIT_FAILURE, "strtol(\"%s\")", optarg);
+      }
+      if (*end != '\0') {
+        errx(EXIT_FAILURE,
+             "Could not convert --probe_interval_ms (\"%s\") to integer",
+             optarg);
+      }
+      if (val < 0 || val > INT_MAX) {
+        errx(EXIT_FAILURE, "--probe_interval_ms must be between 0 and %d",
+             INT_MAX);
+      }
+      probe_interval_ms = (int)val;
+      break;
+    }
+
+    case 'p':
+      if ((mlock_pages = strdup(optarg)) == NULL)
+        err(EXIT_FAILURE, "strdup");
+      break;
+
+    case 'l':
+      if (strcmp(optarg, "files") == 0) {
+        mlock_mode = MLOCK_MODE_FILES;
+      } else if (strcmp(optarg, "onfault") == 0) {
+        mlock_mode = MLOCK_MODE_ONFAULT;
+      } else if (strcmp(optarg, "all") == 0) {
+        mlock_mode = MLOCK_MODE_ALL;
+      } else {
+        errx(EXIT_FAILURE, "Unknown --mlock_mode \"%s\"", optarg);
+      }
+      break;
+
+    case 'R':
+      if ((mlock_record_path = strdup(optarg)) == NULL)
+        err(EXIT_FAILURE, "strdup");
+      break;
+
+    case 'S':
+      print_stats = true;
+      break;
+
+    case 't':
+      if ((trace_path = strdup(optarg)) == NULL)
+        err(EXIT_FAILURE, "strdup");
+      break;
+
     case 'v':
       printf("root-vanished version " VERSION "\n");
       return 0;
@@ -116,135 +298,383 @@ int main(int argc, char *argv[]) {
     }
   }
 
-  char *blockdev = mountpoint_to_blockdev(mountpoint);
-  printf("Resolved mountpoint \"%s\" to block device \"%s\"\n", mountpoint,
-         blockdev);
+  /* mlockall() locks everything, a page list would be ignored. */
+  if (mlock_pages != NULL && mlock_mode == MLOCK_MODE_ALL) {
+    errx(EXIT_FAILURE, "--mlock_pages cannot be used with --mlock_mode=all");
+  }
 
+  if (reexec_memfd) {
+    reexec_from_memfd(argv);
+  }
+  if (print_stats) {
+    atexit(stats_dump);
+  }
+
+  /* Arm the uevent socket before anything else: the kernel queues uevents on
+   * it while the rest of the startup (resolving the block devices, X11, the
+   * message, D-Bus, mlock) runs, so that a removal during the startup is
+   * handled once the main loop runs instead of being missed. The uevents are
+   * matched against the watchset only when they are read. */
+  int uevent_fd = -1;
+  if (mlock_record_path == NULL) {
+    stage = stats_stage_begin("open uevent socket");
+    uevent_fd = uevent_socket_open();
+    stats_stage_end(stage);
+  }
+
+  char *default_mountpoint = "/";
+  if (num_mountpoints == 0) {
+    mountpoints = &default_mountpoint;
+    num_mountpoints = 1;
+  }
+
+  stage = stats_stage_begin("resolve block devices");
+  struct watchset watchset = {0};
+  for (int i = 0; i < num_mountpoints; i++) {
+    struct blockdev blockdev = mountpoint_to_blockdev(mountpoints[i]);
+    printf("Resolved mountpoint \"%s\" to block device \"%s\" (%u:%u)\n",
+           mountpoints[i], blockdev.name, major(blockdev.devnum),
+           minor(blockdev.devnum));
+    resolve_blockdev_ancestry(&blockdev);
+    for (int j = 0; j < blockdev.num_devpaths; j++) {
+      printf("Watching for removal of \"%s\"\n", blockdev.devpaths[j]);
+    }
+    watchset_add(&watchset, &blockdev);
+  }
+  watchset_build(&watchset);
+  stats_stage_end(stage);
+
+  stage = stats_stage_begin("connect to X11");
   int conn_screen;
   xcb_connection_t *conn = xcb_connect(NULL, &conn_screen);
   if (xcb_connection_has_error(conn))
     errx(EXIT_FAILURE, "Cannot open display\n");
+  stats_stage_end(stage);
 
   const xcb_screen_t *root_screen = xcb_aux_get_screen(conn, conn_screen);
-  const int screen_width = root_screen->width_in_pixels;
-  const int screen_height = root_screen->height_in_pixels;
   const xcb_window_t window = xcb_generate_id(conn);
   const xcb_pixmap_t pixmap = xcb_generate_id(conn);
   const xcb_gcontext_t pixmap_gc = xcb_generate_id(conn);
-  int message_height;
-  int message_width;
-  prepare_message_window(conn, root_screen, window, pixmap, pixmap_gc,
-                         &message_width, &message_height, reboot_when_removed);
+  struct message_layout layout;
+  stage = stats_stage_begin("prepare message window");
+  const bool prerendered = prepare_message_window(
+      conn, root_screen, window, pixmap, pixmap_gc, &layout,
+      reboot_when_removed, builtin_font);
+  stats_stage_end(stage);
 
   if (reboot_when_removed) {
-    reboot_prepare();
+    stage = stats_stage_begin("prepare reboot");
+    reboot_prepare(reboot_methods, reboot_logind_timeout_ms);
+    stats_stage_end(stage);
   }
 
-  mlock_files();
+  stage = stats_stage_begin("mlock");
+  if (mlock_record_path != NULL) {
+    /* Nothing is locked in record mode. Instead, forget which code pages were
+     * used so far and run the real removal path against a fake uevent. */
+    mlock_record_prepare();
+    uevent_fd = uevent_socket_fake_removal(&watchset.blockdevs[0]);
+  } else {
+    if (mlock_mode == -1) {
+      mlock_mode = MLOCK_MODE_FILES;
+#ifdef STATIC_BINARY
+      /* Neither the program nor any library is backed by the root file
+       * system, so there is no need to go through /proc/self/maps. What is
+       * left (locale archive, message catalogs) is locked with the rest.
+       * An explicit --mlock_pages takes precedence. */
+      if (running_from_memfd() && mlock_pages == NULL) {
+        mlock_mode = MLOCK_MODE_ALL;
+      }
+#endif
+    }
+    mlock_files(mlock_pages, mlock_mode);
+  }
+  stats_stage_end(stage);
 
-  wait_for_blockdev_removal(blockdev);
+  struct liveness_probe probe = {.num_fds = 0};
+  if (probe_interval_ms > 0) {
+    stage = stats_stage_begin("open liveness probe");
+    liveness_probe_open(&probe, &watchset);
+    stats_stage_end(stage);
+  }
+  stats.idle_wakeup_interval_ms = (probe.num_fds > 0 ? probe_interval_ms : 0);
 
-  /* Map the window (= make it visible) */
-  xcb_map_window(conn, window);
+  /* A block device which vanished before the uevent socket was open (or
+   * before it was resolved, in which case it has no devpaths to match
+   * uevents against) would otherwise be waited for forever. */
+  const struct blockdev *removed = NULL;
+  if (mlock_record_path == NULL) {
+    removed = find_vanished_blockdev(&watchset);
+  } else {
+    /* The fake uevent is handled before the probe timer is, so run the sysfs
+     * checks here once to get their pages recorded as well. */
+    find_vanished_blockdev(&watchset);
+    probe_liveness(&probe);
+  }
+  if (trace_path != NULL) {
+    stats_write_trace(trace_path);
+  }
+  for (int i = 0; i < watchset.num_blockdevs; i++) {
+    printf("Waiting for blockdev \"%s\" (%u:%u) to be removed\n",
+           watchset.blockdevs[i].name, major(watchset.blockdevs[i].devnum),
+           minor(watchset.blockdevs[i].devnum));
+  }
 
-  /* Raise window (put it on top) */
-  xcb_configure_window(conn, window, XCB_CONFIG_WINDOW_STACK_MODE,
-                       (uint32_t[]){XCB_STACK_MODE_ABOVE});
+  /* Everything below is driven by a single epoll_wait() on the uevent socket,
+   * the X11 connection, a timerfd for the next deadline, a periodic timerfd
+   * for the liveness probe (only with --probe_interval_ms) and a signalfd, so
+   * that nothing blocks. The deadline timerfd stays disarmed while there is
+   * no deadline, so by default nothing at all wakes up while idle (see
+   * --stats). */
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  sigaddset(&signals, SIGHUP);
+  if (print_stats) {
+    sigaddset(&signals, SIGUSR1);
+  }
+  if (sigprocmask(SIG_BLOCK, &signals, NULL) == -1)
+    err(EXIT_FAILURE, "sigprocmask");
+  const int signal_fd = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+  if (signal_fd == -1)
+    err(EXIT_FAILURE, "signalfd");
+  const int timer_fd =
+      timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (timer_fd == -1)
+    err(EXIT_FAILURE, "timerfd_create");
+  const int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd == -1)
+    err(EXIT_FAILURE, "epoll_create1");
+  epoll_add(epoll_fd, uevent_fd);
+  epoll_add(epoll_fd, xcb_get_file_descriptor(conn));
+  epoll_add(epoll_fd, timer_fd);
+  epoll_add(epoll_fd, signal_fd);
+  int probe_fd = -1;
+  if (probe.num_fds > 0) {
+    if ((probe_fd = timerfd_create(CLOCK_MONOTONIC,
+                                   TFD_NONBLOCK | TFD_CLOEXEC)) == -1)
+      err(EXIT_FAILURE, "timerfd_create");
+    /* The first probe runs right away. */
+    const struct itimerspec its = {
+        .it_interval = {probe_interval_ms / 1000,
+                        (probe_interval_ms % 1000) * 1000000},
+        .it_value = {0, 1},
+    };
+    if (timerfd_settime(probe_fd, 0, &its, NULL) == -1)
+      err(EXIT_FAILURE, "timerfd_settime");
+    epoll_add(epoll_fd, probe_fd);
+  }
 
-  /* Copy the contents of the pixmap to the real window */
-  for (int x = 0; x < screen_width; x += message_width) {
-    for (int y = 0; y < screen_height; y += message_height) {
-      xcb_copy_area(conn, pixmap, window, pixmap_gc, 0, 0, x, y, message_width,
-                    message_height);
+  int64_t mapped_ms = -1;
+  struct keyboard_grab grab = {.state = KEYBOARD_GRAB_SUCCESS};
+  /* When to reboot because the keyboard could not be grabbed, or -1 */
+  int64_t fallback_reboot_ms = -1;
+  /* When to check sysfs again because uevents were lost, or -1 */
+  int64_t recheck_ms = -1;
+  struct damage damage = {.num_rects = 0};
+  /* An event xcb had already queued when we were about to block, see below */
+  xcb_generic_event_t *queued = NULL;
+  for (;;) {
+    if (xcb_connection_has_error(conn)) {
+      warnx("X11 connection closed, exiting");
+      return 0;
     }
-  }
-  xcb_flush(conn);
 
-  struct timeval start_tv;
-  if (gettimeofday(&start_tv, NULL) == -1) {
-    start_tv.tv_sec = 0;
-    start_tv.tv_usec = 0;
-  }
+    /* xcb may have read events into its queue while waiting for a reply, so
+     * drain it on every iteration instead of only when the fd is readable. */
+    xcb_generic_event_t *event;
+    while ((event = (queued != NULL ? queued : xcb_poll_for_event(conn))) !=
+           NULL) {
+      queued = NULL;
+      if (event->response_type == 0) {
+        warnx("X11 error received for sequence %x", event->sequence);
+        free(event);
+        continue;
+      }
 
-  if (reboot_when_removed) {
-    /* When rebooting is enabled, grab the keyboard to listen for input and
-     * reboot once a key was pressed. */
-    int tries = 10000;
-    while (tries-- > 0) {
-      const xcb_grab_keyboard_cookie_t kcookie =
-          xcb_grab_keyboard(conn, true, root_screen->root, XCB_CURRENT_TIME,
-                            XCB_GRAB_MODE_ASYNC, XCB_GRAB_MODE_ASYNC);
-
-      xcb_grab_keyboard_reply_t *kreply;
-      if ((kreply = xcb_grab_keyboard_reply(conn, kcookie, NULL)) &&
-          kreply->status == XCB_GRAB_STATUS_SUCCESS) {
-        free(kreply);
+      /* Strip off the highest bit (set if the event is generated) */
+      int type = (event->response_type & 0x7F);
+
+      switch (type) {
+      case XCB_KEY_PRESS:
+        /* Verify at least 0.5s passed to prevent accidental inputs */
+        if (reboot_when_removed) {
+          if (monotonic_ms() - mapped_ms >= 500) {
+            reboot();
+          }
+          return 0;
+        }
         break;
+
+      case XCB_EXPOSE:
+        /* A prerendered background is repainted by the X server itself. */
+        if (prerendered) {
+          break;
+        }
+        /* Collect the exposed areas until the last expose event of this
+         * burst (count == 0) arrives, then copy only the tiles intersecting
+         * them. */
+        const xcb_expose_event_t *expose = (xcb_expose_event_t *)event;
+        damage_add(&damage, &(xcb_rectangle_t){expose->x, expose->y,
+                                               expose->width, expose->height});
+        if (expose->count > 0) {
+          break;
+        }
+        copy_message_tiles_damaged(conn, pixmap, window, pixmap_gc, &damage,
+                                   &layout);
+        break;
+
+      case XCB_VISIBILITY_NOTIFY:
+        if (((xcb_visibility_notify_event_t *)event)->state !=
+            XCB_VISIBILITY_UNOBSCURED) {
+          xcb_configure_window(conn, window, XCB_CONFIG_WINDOW_STACK_MODE,
+                               (uint32_t[]){XCB_STACK_MODE_ABOVE});
+        }
+        break;
+      }
+
+      free(event);
+    }
+
+    if (grab.state == KEYBOARD_GRAB_IN_FLIGHT ||
+        grab.state == KEYBOARD_GRAB_BACKOFF) {
+      grab_keyboard_process(conn, &grab);
+      if (grab.state == KEYBOARD_GRAB_FAILED && mlock_record_path == NULL) {
+        warnx("Could not grab keyboard. Will reboot in %d seconds.",
+              reboot_fallback_seconds);
+        if (reboot_fallback_seconds > -1) {
+          fallback_reboot_ms =
+              monotonic_ms() + (int64_t)reboot_fallback_seconds * 1000;
+        }
       }
+    }
 
-      usleep(50);
+    if (mlock_record_path != NULL && removed != NULL &&
+        (grab.state == KEYBOARD_GRAB_SUCCESS ||
+         grab.state == KEYBOARD_GRAB_FAILED)) {
+      /* Cover what is left of the removal path: redrawing on expose, and the
+       * D-Bus call (without rebooting). */
+      if (!prerendered) {
+        copy_message_tiles(conn, pixmap, window, pixmap_gc, &layout);
+        xcb_flush(conn);
+      }
+      if (reboot_when_removed) {
+        reboot_rehearse();
+      }
+      mlock_record(mlock_record_path);
+      return 0;
+    }
+
+    if (fallback_reboot_ms != -1 && monotonic_ms() >= fallback_reboot_ms) {
+      warnx("Rebooting, %d seconds passed", reboot_fallback_seconds);
+      fallback_reboot_ms = -1;
+      reboot();
     }
 
-    if (tries <= 0) {
-      warnx("Could not grab keyboard. Will reboot in %d seconds.",
-            reboot_fallback_seconds);
-      if (reboot_fallback_seconds > -1) {
-        sleep(reboot_fallback_seconds);
-        warnx("Rebooting, %d seconds passed", reboot_fallback_seconds);
-        reboot();
+    if (recheck_ms != -1 && monotonic_ms() >= recheck_ms) {
+      recheck_ms = -1;
+      if (removed == NULL) {
+        removed = find_vanished_blockdev(&watchset);
       }
     }
-  }
 
-  xcb_generic_event_t *event;
-  while ((event = xcb_wait_for_event(conn)) != NULL) {
-    if (event->response_type == 0) {
-      warn("X11 error received for sequence %x", event->sequence);
-      continue;
+    int64_t deadline_ms = grab_keyboard_deadline_ms(&grab);
+    if (fallback_reboot_ms != -1 &&
+        (deadline_ms == -1 || fallback_reboot_ms < deadline_ms)) {
+      deadline_ms = fallback_reboot_ms;
+    }
+    if (recheck_ms != -1 && (deadline_ms == -1 || recheck_ms < deadline_ms)) {
+      deadline_ms = recheck_ms;
     }
+    timer_arm(timer_fd, deadline_ms);
 
-    /* Strip off the highest bit (set if the event is generated) */
-    int type = (event->response_type & 0x7F);
+    xcb_flush(conn);
+    /* grab_keyboard_process() and xcb_flush() read from the X11 connection
+     * after the queue was drained above. Events they queued would not make
+     * the fd readable, so do not block until they are handled. Likewise if
+     * the removal was found without a uevent (see above), so that the window
+     * gets mapped right away. */
+    queued = xcb_poll_for_queued_event(conn);
+    struct epoll_event events[5];
+    const int n =
+        epoll_wait(epoll_fd, events, 5,
+                   (queued != NULL || (removed != NULL && mapped_ms == -1))
+                       ? 0
+                       : -1);
+    if (n == -1) {
+      if (errno == EINTR)
+        continue;
+      err(EXIT_FAILURE, "epoll_wait");
+    }
+    stats.wakeups++;
 
-    switch (type) {
-    case XCB_KEY_PRESS:
-      /* Verify at least 0.5s passed to prevent accidental inputs */
-      if (reboot_when_removed) {
-        bool too_quickly = false;
-        struct timeval keypress_tv;
-        if (gettimeofday(&keypress_tv, NULL) == 0) {
-          struct timeval diff;
-          timersub(&keypress_tv, &start_tv, &diff);
-          too_quickly = (diff.tv_sec == 0 && diff.tv_usec < 500000);
+    for (int i = 0; i < n; i++) {
+      const int fd = events[i].data.fd;
+      if (fd == signal_fd) {
+        struct signalfd_siginfo si;
+        if (read(signal_fd, &si, sizeof(si)) != sizeof(si)) {
+          continue;
+        }
+        if (si.ssi_signo == SIGUSR1) {
+          stats_dump();
+        } else {
+          warnx("Received %s, exiting", strsignal(si.ssi_signo));
+          return 0;
         }
-        if (!too_quickly) {
-          reboot();
+      } else if (fd == timer_fd) {
+        /* Only clears the expiration, the deadlines are checked above. */
+        uint64_t expirations;
+        if (read(timer_fd, &expirations, sizeof(expirations)) == -1 &&
+            errno != EAGAIN)
+          err(EXIT_FAILURE, "read(timerfd)");
+      } else if (fd == uevent_fd && removed == NULL) {
+        bool overflowed = false;
+        removed = uevent_socket_read(uevent_fd, &watchset, &overflowed);
+        if (overflowed && removed == NULL) {
+          recheck_ms = monotonic_ms() + UEVENT_RECHECK_MS;
         }
-        return 0;
+      } else if (fd == probe_fd && removed == NULL) {
+        uint64_t expirations;
+        if (read(probe_fd, &expirations, sizeof(expirations)) == -1 &&
+            errno != EAGAIN)
+          err(EXIT_FAILURE, "read(timerfd)");
+        stats.probe_wakeups++;
+        removed = probe_liveness(&probe);
       }
-      break;
+      /* The X11 connection is drained at the top of the loop. */
+    }
+
+    if (removed != NULL && mapped_ms == -1) {
+      /* Neither source of removals is needed anymore. */
+      epoll_ctl(epoll_fd, EPOLL_CTL_DEL, uevent_fd, NULL);
+      close(uevent_fd);
+      if (probe_fd != -1) {
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, probe_fd, NULL);
+        close(probe_fd);
+      }
+      printf("Block device \"%s\" vanished\n", removed->name);
+
+      /* Map the window (= make it visible) */
+      xcb_map_window(conn, window);
+
+      /* Raise window (put it on top) */
+      xcb_configure_window(conn, window, XCB_CONFIG_WINDOW_STACK_MODE,
+                           (uint32_t[]){XCB_STACK_MODE_ABOVE});
 
-    case XCB_EXPOSE:
       /* Copy the contents of the pixmap to the real window */
-      for (int x = 0; x < screen_width; x += message_width) {
-        for (int y = 0; y < screen_height; y += message_height) {
-          xcb_copy_area(conn, pixmap, window, pixmap_gc, 0, 0, x, y,
-                        message_width, message_height);
-        }
+      if (!prerendered) {
+        copy_message_tiles(conn, pixmap, window, pixmap_gc, &layout);
       }
       xcb_flush(conn);
-      break;
 
-    case XCB_VISIBILITY_NOTIFY:
-      if (((xcb_visibility_notify_event_t *)event)->state !=
-          XCB_VISIBILITY_UNOBSCURED) {
-        xcb_configure_window(conn, window, XCB_CONFIG_WINDOW_STACK_MODE,
-                             (uint32_t[]){XCB_STACK_MODE_ABOVE});
-        xcb_flush(conn);
+      mapped_ms = monotonic_ms();
+
+      if (reboot_when_removed) {
+        /* When rebooting is enabled, grab the keyboard to listen for input
+         * and reboot once a key was pressed. */
+        grab_keyboard_start(conn, root_screen->root, &grab);
       }
-      break;
     }
-
-    free(event);
   }
 }
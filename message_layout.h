@@ -0,0 +1,15 @@
+#pragma once
+
+/* Maximum number of outputs (monitors) the message is placed on */
+#define MAX_OUTPUTS 16
+
+/* Where the message goes on the screen. Each output is covered with copies
+ * (tiles) of the message, in a grid which is centered on the output. */
+struct message_layout {
+  /* By how much the message is enlarged for high resolution screens */
+  int scale;
+  int message_width;
+  int message_height;
+  xcb_rectangle_t outputs[MAX_OUTPUTS];
+  int num_outputs;
+};
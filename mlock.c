@@ -14,81 +14,427 @@
  * limitations under the License.
  */
 #include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
 #include <err.h>
 #include <stdlib.h>
-#include <errno.h>
-#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <sys/mman.h>
 #include <string.h>
 
-static unsigned long long int must_hex_to_int(const char *hex) {
-  char *end = NULL;
-  errno = 0;
-  const unsigned long long int val = strtoull(hex, &end, 16);
-  if ((errno == ERANGE && (val == ULLONG_MAX)) || (errno != 0 && val == 0)) {
-    err(EXIT_FAILURE, "strtoull");
-  }
+#include "mlock.h"
+
+/* A file-backed mapping, as listed in /proc/self/maps. */
+struct mapping {
+  unsigned long long int start;
+  unsigned long long int end;
+  unsigned long long int offset;
+  unsigned long long int inode;
+  /* Not NUL-terminated, always 4 characters */
+  const char *perms;
+  const char *pathname;
+};
+
+/* A range of a file which needs to stay in memory, see mlock_record(). */
+struct page_range {
+  unsigned long long int inode;
+  unsigned long long int offset;
+  unsigned long long int length;
+  char *pathname;
+};
+
+/* /proc/self/maps is read into this buffer in one go and parsed in place.
+ * Even with fonts and gconv modules loaded, it is far below this size. */
+static char maps[256 * 1024];
 
-  if (*end != '\0') {
-    errx(EXIT_FAILURE,
-         "invalid entry in /proc/self/maps, could not interpret \"%s\" as hex",
-         hex);
+/*
+ * Parses a hexadecimal number at *p, advancing *p past it. Returns false if
+ * there are no hex digits at *p.
+ *
+ */
+static bool scan_hex(char **p, unsigned long long int *val) {
+  const char *start = *p;
+  *val = 0;
+  for (;; (*p)++) {
+    const char c = **p;
+    if (c >= '0' && c <= '9') {
+      *val = (*val << 4) | (c - '0');
+    } else if (c >= 'a' && c <= 'f') {
+      *val = (*val << 4) | (c - 'a' + 10);
+    } else {
+      break;
+    }
   }
+  return *p != start;
+}
 
-  return val;
+/* Advances *p past the current field and the spaces following it. */
+static void skip_field(char **p) {
+  while (**p != ' ' && **p != '\n' && **p != '\0') {
+    (*p)++;
+  }
+  while (**p == ' ') {
+    (*p)++;
+  }
 }
 
-void mlock_files(void) {
-  unsigned long long int mlocked = 0;
-  FILE *f = fopen("/proc/self/maps", "r");
-  if (f == NULL) {
-    err(EXIT_FAILURE, "fopen(/proc/self/maps)");
+/*
+ * Calls cb for every mapping in /proc/self/maps which refers to a file, until
+ * cb returns false. The strings in the mapping passed to cb point into a
+ * static buffer and are only valid until the next call.
+ *
+ */
+static void for_each_file_mapping(bool (*cb)(const struct mapping *, void *),
+                                  void *data) {
+  const int fd = open("/proc/self/maps", O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    err(EXIT_FAILURE, "open(/proc/self/maps)");
   }
-  char *starthex = NULL;
-  char *endhex = NULL;
-  char *perms = NULL;
-  char *pathname = NULL;
-  char buffer[4096];
-  while ((fgets(buffer, sizeof(buffer), f) != NULL)) {
-    /* free(NULL) is defined as a no-op, and freeing old variables allows us
-     * to use “continue” below. */
-    free(starthex);
-    free(endhex);
-    free(perms);
-    free(pathname);
+  size_t len = 0;
+  ssize_t n;
+  while ((n = read(fd, maps + len, sizeof(maps) - 1 - len)) > 0) {
+    len += n;
+  }
+  if (n == -1) {
+    err(EXIT_FAILURE, "read(/proc/self/maps)");
+  }
+  close(fd);
+  if (len == sizeof(maps) - 1) {
+    errx(EXIT_FAILURE, "/proc/self/maps exceeds %zu bytes", sizeof(maps) - 1);
+  }
+  maps[len] = '\0';
+
+  char *line = maps;
+  while (*line != '\0') {
+    char *eol = strchr(line, '\n');
+    if (eol == NULL) {
+      eol = line + strlen(line);
+    } else {
+      *eol++ = '\0';
+    }
     /* Format (see proc(5)):
      * address           perms offset  dev   inode       pathname
      * 00400000-00452000 r-xp 00000000 08:02 173521      /usr/bin/dbus-daemon */
-    const int ret = sscanf(buffer, "%m[^-]-%ms %ms %*s %*s %*s %ms", &starthex,
-                           &endhex, &perms, &pathname);
-    if (ret == EOF) {
-      break;
+    struct mapping m;
+    const char *entry = line;
+    char *p = line;
+    line = eol;
+    if (!scan_hex(&p, &m.start) || *p++ != '-' || !scan_hex(&p, &m.end) ||
+        *p++ != ' ') {
+      errx(EXIT_FAILURE, "invalid entry in /proc/self/maps: \"%s\"", entry);
     }
-    if (ret < 4) {
+    m.perms = p;
+    skip_field(&p);
+    if (!scan_hex(&p, &m.offset)) {
       continue;
     }
-    if (*pathname != '/') {
+    skip_field(&p);
+    skip_field(&p); /* dev */
+    m.inode = strtoull(p, &p, 10);
+    while (*p == ' ') {
+      p++;
+    }
+    m.pathname = p;
+    if (*m.pathname != '/') {
       /* Ignore all mappings which do not refer to files. The point of
        * mlock()ing is to make (failing) file system access unnecessary. */
       continue;
     }
-    if (strcmp(perms, "---p") == 0) {
+    if (strncmp(m.perms, "---p", 4) == 0) {
       /* Ignore the unmapped gap, for more details, see
        * http://unix.stackexchange.com/a/226317 */
       continue;
     }
-    const unsigned long long int start = must_hex_to_int(starthex);
-    const unsigned long long int end = must_hex_to_int(endhex);
-    const unsigned long long int len = (end - start);
-    if (mlock((const void *)start, len) == -1) {
-      warn("mlock(%llu, %llu) (for \"%s\")", start, len, pathname);
-      warnx("Not all files could be locked into memory. Verify RLIMIT_MEMLOCK "
-            "is set to RLIMIT_INFINITY (check ulimit -l).");
-      fclose(f);
-      return;
+    if (!cb(&m, data)) {
+      break;
+    }
+  }
+}
+
+struct lock_state {
+  enum mlock_mode mode;
+  /* NULL when locking all file-backed mappings in full */
+  struct page_range *ranges;
+  int num_ranges;
+  /* Address range for the next mlock() call. Adjacent ranges of the same file
+   * are merged into it, so that each file takes as few calls as possible. */
+  unsigned long long int pending_start;
+  unsigned long long int pending_end;
+  const char *pending_pathname;
+  /* Bytes locked of the file currently being processed, for the report */
+  const char *pathname;
+  unsigned long long int file_mlocked;
+  unsigned long long int mlocked;
+};
+
+static void report_file(struct lock_state *state) {
+  if (state->pathname != NULL) {
+    printf("mlocked %llu bytes of \"%s\"\n", state->file_mlocked,
+           state->pathname);
+  }
+  state->file_mlocked = 0;
+}
+
+static bool flush_pending(struct lock_state *state) {
+  const unsigned long long int start = state->pending_start;
+  const unsigned long long int len = state->pending_end - start;
+  if (len == 0) {
+    return true;
+  }
+  state->pending_start = state->pending_end = 0;
+  const int ret = (state->mode == MLOCK_MODE_ONFAULT
+                       ? mlock2((const void *)start, len, MLOCK_ONFAULT)
+                       : mlock((const void *)start, len));
+  if (ret == -1) {
+    warn("mlock(%llu, %llu) (for \"%s\")", start, len,
+         state->pending_pathname);
+    warnx("Not all files could be locked into memory. Verify RLIMIT_MEMLOCK "
+          "is set to RLIMIT_INFINITY (check ulimit -l).");
+    return false;
+  }
+  if (state->pathname == NULL ||
+      strcmp(state->pathname, state->pending_pathname) != 0) {
+    report_file(state);
+    state->pathname = state->pending_pathname;
+  }
+  state->file_mlocked += len;
+  state->mlocked += len;
+  return true;
+}
+
+static bool lock_range(struct lock_state *state, unsigned long long int start,
+                       unsigned long long int len, const char *pathname) {
+  if (state->pending_end == start && state->pending_pathname != NULL &&
+      strcmp(state->pending_pathname, pathname) == 0) {
+    state->pending_end += len;
+    return true;
+  }
+  if (!flush_pending(state)) {
+    return false;
+  }
+  state->pending_start = start;
+  state->pending_end = start + len;
+  state->pending_pathname = pathname;
+  return true;
+}
+
+static bool lock_mapping(const struct mapping *m, void *data) {
+  struct lock_state *state = data;
+  const unsigned long long int len = (m->end - m->start);
+  bool known = false;
+  for (int i = 0; i < state->num_ranges; i++) {
+    const struct page_range *r = &(state->ranges[i]);
+    if (r->inode != m->inode || strcmp(r->pathname, m->pathname) != 0) {
+      continue;
+    }
+    known = true;
+    /* Intersect the recorded file range with the part of the file mapped
+     * here. */
+    const unsigned long long int from =
+        (r->offset > m->offset ? r->offset : m->offset);
+    const unsigned long long int to =
+        (r->offset + r->length < m->offset + len ? r->offset + r->length
+                                                 : m->offset + len);
+    if (from >= to) {
+      continue;
+    }
+    if (!lock_range(state, m->start + (from - m->offset), to - from,
+                    m->pathname)) {
+      return false;
+    }
+  }
+  if (known) {
+    return true;
+  }
+  if (state->ranges != NULL) {
+    warnx("\"%s\" (inode %llu) is not in the page list, locking it in full",
+          m->pathname, m->inode);
+  }
+  return lock_range(state, m->start, len, m->pathname);
+}
+
+/* Returns VmLck from /proc/self/status in bytes, or 0 if it is unavailable. */
+static unsigned long long int locked_bytes(void) {
+  FILE *f = fopen("/proc/self/status", "r");
+  if (f == NULL) {
+    return 0;
+  }
+  unsigned long long int kib = 0;
+  char buffer[256];
+  while (fgets(buffer, sizeof(buffer), f) != NULL) {
+    if (sscanf(buffer, "VmLck: %llu kB", &kib) == 1) {
+      break;
+    }
+  }
+  fclose(f);
+  return kib * 1024;
+}
+
+/*
+ * Reads a page list written by mlock_record(). Each line consists of inode,
+ * file offset and length (both hex) and the file name. A length of 0 marks a
+ * file which is mapped but of which no page needs to be locked.
+ *
+ */
+static void read_page_list(const char *path, struct lock_state *state) {
+  FILE *f = fopen(path, "r");
+  if (f == NULL) {
+    err(EXIT_FAILURE, "fopen(%s)", path);
+  }
+  char buffer[4096];
+  while ((fgets(buffer, sizeof(buffer), f) != NULL)) {
+    struct page_range r;
+    int pathname_offset;
+    if (buffer[0] == '#' ||
+        sscanf(buffer, "%llu %llx %llx %n", &r.inode, &r.offset, &r.length,
+               &pathname_offset) != 3) {
+      continue;
+    }
+    buffer[strcspn(buffer, "\n")] = '\0';
+    if ((r.pathname = strdup(buffer + pathname_offset)) == NULL) {
+      err(EXIT_FAILURE, "strdup");
+    }
+    state->ranges = realloc(state->ranges, (state->num_ranges + 1) *
+                                               sizeof(struct page_range));
+    if (state->ranges == NULL) {
+      err(EXIT_FAILURE, "realloc");
     }
-    mlocked += len;
+    state->ranges[state->num_ranges++] = r;
   }
-  printf("mlocked %llu bytes\n", mlocked);
   fclose(f);
 }
+
+/*
+ * mlock()s all file-backed mappings, so that the root file system does not
+ * need to be accessed once it vanished. If page_list is not NULL, only the
+ * pages listed in it (see mlock_record()) are locked of the files it covers.
+ *
+ * With MLOCK_MODE_ONFAULT, pages are only locked once they are used, which
+ * makes startup cheaper but relies on the pages being used before the root
+ * file system vanishes. MLOCK_MODE_ALL locks everything with mlockall()
+ * without looking at /proc/self/maps, so page_list must be NULL.
+ *
+ */
+void mlock_files(const char *page_list, enum mlock_mode mode) {
+  if (mode == MLOCK_MODE_ALL) {
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) == -1) {
+      warn("mlockall(MCL_CURRENT | MCL_FUTURE)");
+    }
+    printf("mlocked %llu bytes\n", locked_bytes());
+    return;
+  }
+
+  struct lock_state state = {
+      .mode = mode,
+  };
+  if (page_list != NULL) {
+    read_page_list(page_list, &state);
+    if (state.ranges == NULL) {
+      errx(EXIT_FAILURE, "page list %s is empty", page_list);
+    }
+  }
+  for_each_file_mapping(lock_mapping, &state);
+  if (flush_pending(&state)) {
+    report_file(&state);
+  }
+  printf("mlocked %llu bytes\n", state.mlocked);
+}
+
+static bool drop_mapping(const struct mapping *m, void *data) {
+  (void)data;
+  /* Only executable mappings are dropped: writable and read-only mappings
+   * (RELRO after relocation) may hold private modifications which
+   * MADV_DONTNEED would discard. */
+  if (strncmp(m->perms, "r-xp", 4) == 0 &&
+      madvise((void *)m->start, m->end - m->start, MADV_DONTNEED) == -1) {
+    warn("madvise(%s)", m->pathname);
+  }
+  return true;
+}
+
+/*
+ * Unmaps the pages of executable file mappings from the page table, so that
+ * mlock_record() only sees the code which ran in the meantime. The pages are
+ * faulted back in from the page cache when they are used.
+ *
+ */
+void mlock_record_prepare(void) {
+  for_each_file_mapping(drop_mapping, NULL);
+}
+
+struct record_state {
+  FILE *out;
+  int pagemap;
+  long page_size;
+  unsigned long long int recorded;
+};
+
+static bool record_mapping(const struct mapping *m, void *data) {
+  struct record_state *state = data;
+  const unsigned long long int num_pages =
+      (m->end - m->start) / state->page_size;
+  uint64_t *entries = calloc(num_pages, sizeof(uint64_t));
+  if (entries == NULL) {
+    err(EXIT_FAILURE, "calloc");
+  }
+  const off_t entries_offset = (m->start / state->page_size) * sizeof(uint64_t);
+  if (pread(state->pagemap, entries, num_pages * sizeof(uint64_t),
+            entries_offset) != (ssize_t)(num_pages * sizeof(uint64_t))) {
+    err(EXIT_FAILURE, "pread(/proc/self/pagemap)");
+  }
+
+  bool any_present = false;
+  unsigned long long int first = 0;
+  for (unsigned long long int page = 0; page <= num_pages; page++) {
+    /* Bit 63 is set for present pages, see
+     * linux/Documentation/admin-guide/mm/pagemap.rst */
+    const bool present = (page < num_pages && (entries[page] >> 63) & 1);
+    if (present) {
+      continue;
+    }
+    if (page > first) {
+      fprintf(state->out, "%llu %llx %llx %s\n", m->inode,
+              m->offset + first * state->page_size,
+              (page - first) * state->page_size, m->pathname);
+      state->recorded += (page - first) * state->page_size;
+      any_present = true;
+    }
+    first = page + 1;
+  }
+  if (!any_present) {
+    /* Declare the file as known, so that it is not locked in full. */
+    fprintf(state->out, "%llu 0 0 %s\n", m->inode, m->pathname);
+  }
+  free(entries);
+  return true;
+}
+
+/*
+ * Writes the file ranges of all pages which are currently mapped into our
+ * page tables to path, in the format read by mlock_files(). File offsets
+ * are recorded instead of addresses, as the latter differ with each run.
+ *
+ */
+void mlock_record(const char *path) {
+  struct record_state state = {
+      .out = fopen(path, "w"),
+      .pagemap = open("/proc/self/pagemap", O_RDONLY),
+      .page_size = sysconf(_SC_PAGESIZE),
+      .recorded = 0,
+  };
+  if (state.out == NULL) {
+    err(EXIT_FAILURE, "fopen(%s)", path);
+  }
+  if (state.pagemap == -1) {
+    err(EXIT_FAILURE, "open(/proc/self/pagemap)");
+  }
+  fprintf(state.out, "# root-vanished page list: inode offset length file\n");
+  for_each_file_mapping(record_mapping, &state);
+  if (fclose(state.out) != 0) {
+    err(EXIT_FAILURE, "fclose(%s)", path);
+  }
+  close(state.pagemap);
+  printf("Recorded %llu bytes in %s\n", state.recorded, path);
+}
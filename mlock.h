@@ -1,3 +1,14 @@
 #pragma once
 
-void mlock_files(void);
+enum mlock_mode {
+  /* mlock() file-backed mappings */
+  MLOCK_MODE_FILES,
+  /* mlock2(MLOCK_ONFAULT) file-backed mappings */
+  MLOCK_MODE_ONFAULT,
+  /* mlockall(MCL_CURRENT | MCL_FUTURE) */
+  MLOCK_MODE_ALL,
+};
+
+void mlock_files(const char *page_list, enum mlock_mode mode);
+void mlock_record_prepare(void);
+void mlock_record(const char *path);
@@ -0,0 +1,4 @@
+#pragma once
+
+int64_t monotonic_ms(void);
+int64_t monotonic_us(void);
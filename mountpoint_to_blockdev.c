@@ -18,8 +18,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
+#include <sys/types.h>
+#include <sys/stat.h>
 
-char *mountpoint_to_blockdev(const char *mountpoint) {
+#include "blockdev.h"
+
+struct blockdev mountpoint_to_blockdev(const char *mountpoint) {
   printf("Finding blockdevice mounted at mountpoint %s\n", mountpoint);
   FILE *f = fopen("/proc/mounts", "r");
   if (f == NULL) {
@@ -42,6 +46,9 @@ char *mountpoint_to_blockdev(const char *mountpoint) {
     }
     printf("Canonicalizing path %s\n", fs_spec);
     char *fs_spec_real = realpath(fs_spec, NULL);
+    if (fs_spec_real == NULL) {
+      err(EXIT_FAILURE, "realpath(%s)", fs_spec);
+    }
     free(fs_spec);
     fclose(f);
     if (strncmp(fs_spec_real, "/dev/", strlen("/dev/")) != 0) {
@@ -49,8 +56,17 @@ char *mountpoint_to_blockdev(const char *mountpoint) {
                          "match with hotplug events later",
            fs_spec_real);
     }
+    struct stat st;
+    if (stat(fs_spec_real, &st) == -1) {
+      err(EXIT_FAILURE, "stat(%s)", fs_spec_real);
+    }
+    if (!S_ISBLK(st.st_mode)) {
+      errx(EXIT_FAILURE, "%s is not a block device", fs_spec_real);
+    }
     // Strip /dev/ prefix.
-    return fs_spec_real + strlen("/dev/");
+    return (struct blockdev){
+        .name = fs_spec_real + strlen("/dev/"), .devnum = st.st_rdev,
+    };
   }
   errx(EXIT_FAILURE, "Could not find --mountpoint=%s in /proc/mounts",
        mountpoint);
@@ -1,3 +1,3 @@
 #pragma once
 
-char *mountpoint_to_blockdev(const char *mountpoint);
+struct blockdev mountpoint_to_blockdev(const char *mountpoint);
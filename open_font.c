@@ -18,6 +18,12 @@
 #include <err.h>
 #include <string.h>
 
+/*
+ * Opens the first X11 core font matching pattern and stores its height in
+ * font_height. Returns XCB_NONE (after printing a warning) if the X server
+ * has no such font.
+ *
+ */
 xcb_font_t open_font(xcb_connection_t *conn, const char *pattern,
                      int *font_height) {
   const xcb_font_t result = xcb_generate_id(conn);
@@ -28,18 +34,22 @@ xcb_font_t open_font(xcb_connection_t *conn, const char *pattern,
 
   xcb_generic_error_t *error = xcb_request_check(conn, font_cookie);
   if (error != NULL) {
-    errx(EXIT_FAILURE,
-         "Could not open X11 font by pattern \"%s\", X11 error code %d",
-         pattern, error->error_code);
+    warnx("Could not open X11 font by pattern \"%s\", X11 error code %d",
+          pattern, error->error_code);
+    free(error);
+    xcb_discard_reply(conn, info_cookie.sequence);
+    return XCB_NONE;
   }
 
   error = NULL;
   xcb_list_fonts_with_info_reply_t *reply =
       xcb_list_fonts_with_info_reply(conn, info_cookie, &error);
-  if (reply == NULL || error != NULL) {
-    errx(EXIT_FAILURE,
-         "Could not open X11 font by pattern \"%s\", X11 error code %d",
-         pattern, error->error_code);
+  if (reply == NULL) {
+    warnx("Could not query X11 font by pattern \"%s\", X11 error code %d",
+          pattern, (error != NULL ? error->error_code : 0));
+    free(error);
+    xcb_close_font(conn, result);
+    return XCB_NONE;
   }
 
   *font_height = reply->font_ascent + reply->font_descent;
@@ -14,8 +14,10 @@
  * limitations under the License.
  */
 #include <stdlib.h>
+#include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <err.h>
 #include <xcb/xcb.h>
 
 #include "gettext.h"
@@ -24,51 +26,162 @@
 #include "get_colorpixel.h"
 #include "open_fullscreen_window.h"
 #include "open_font.h"
-#include "utf8_to_ucs2.h"
+#include "text_layout.h"
+#include "layout_text.h"
+#include "bitmap_font.h"
+#include "client_image.h"
+#include "create_client_image.h"
+#include "draw_bitmap_text.h"
+#include "upload_image.h"
+#include "message_layout.h"
+#include "query_outputs.h"
+#include "copy_message_tiles.h"
 
-void prepare_message_window(xcb_connection_t *conn,
+/* Space between the text and the left/right and bottom edge of the message */
+#define MESSAGE_MARGIN 20
+#define MESSAGE_BOTTOM_MARGIN 12
+/* Vertical space between two lines of text */
+#define MESSAGE_LINE_SPACING 2
+
+/* Width of the message at scale 1 */
+#define MESSAGE_WIDTH 1024
+
+/* The resolution at which the message is shown at its original size */
+#define BASE_DPI 96
+
+/*
+ * Integer factor by which to enlarge the message, so that it has the same
+ * physical size as at BASE_DPI on the output with the highest resolution. The
+ * message does not get wider than the narrowest output, though.
+ *
+ */
+static int message_scale(const struct message_layout *layout, int dpi) {
+  int scale = (dpi + BASE_DPI / 2) / BASE_DPI;
+  for (int i = 0; i < layout->num_outputs; i++) {
+    while (scale > 1 && MESSAGE_WIDTH * scale > layout->outputs[i].width) {
+      scale--;
+    }
+  }
+  return (scale < 1 ? 1 : scale);
+}
+
+/*
+ * Creates the (unmapped) fullscreen window, renders the message into pixmap
+ * (with the X server's fixed font or, if builtin_font is set, the screen has
+ * a high resolution or that font is missing, the compiled-in one) and computes
+ * where it goes on each output (monitor). If possible, the whole screen is
+ * also rendered once into a pixmap which becomes the window background: the X
+ * server then paints the window on map and on expose without any request from
+ * us, and true is returned.
+ * Otherwise (the server cannot allocate a pixmap of the screen size), false
+ * is returned and the caller has to copy the message tiles itself.
+ *
+ */
+bool prepare_message_window(xcb_connection_t *conn,
                             const xcb_screen_t *root_screen,
                             xcb_window_t window, xcb_pixmap_t pixmap,
-                            xcb_gcontext_t pixmap_gc, int *message_width,
-                            int *message_height,
-                            const bool reboot_when_removed) {
+                            xcb_gcontext_t pixmap_gc,
+                            struct message_layout *layout,
+                            const bool reboot_when_removed,
+                            const bool builtin_font) {
   const uint32_t background = get_colorpixel(conn, root_screen, "#0000A8");
   const uint32_t foreground = get_colorpixel(conn, root_screen, "#FFFFFE");
   const uint16_t screen_width = root_screen->width_in_pixels;
   const uint16_t screen_height = root_screen->height_in_pixels;
   open_fullscreen_window(conn, window, root_screen, screen_width, screen_height,
                          background);
+  int dpi;
+  layout->num_outputs =
+      query_outputs(conn, root_screen, layout->outputs, MAX_OUTPUTS, &dpi);
+  layout->scale = message_scale(layout, dpi);
+  printf("Screen resolution is %d dpi, scaling the message by %d\n", dpi,
+         layout->scale);
+
+  /* The X server's fixed fonts are not available in sizes for high resolution
+   * screens, the compiled-in font is scaled up instead (on the client side).
+   * Margins, line spacing and message size are scaled along with it. */
+  const int scale = layout->scale;
   int font_height;
-  xcb_font_t font = open_font(
-      conn, "-misc-fixed-bold-r-normal--18-*-iso10646-1", &font_height);
-  *message_width = 1024;
-  *message_height = 2 * (font_height + 8);
+  xcb_font_t font = XCB_NONE;
+  if (!builtin_font && scale == 1) {
+    font = open_font(conn, "-misc-fixed-bold-r-normal--18-*-iso10646-1",
+                     &font_height);
+    if (font == XCB_NONE) {
+      warnx("Falling back to the built-in font");
+    }
+  }
+  int advance = 0;
+  if (font == XCB_NONE) {
+    font_height = BITMAP_FONT_HEIGHT * scale;
+    advance = BITMAP_FONT_WIDTH * scale;
+  }
+  const char *strings[] = {
+      _("The root file system vanished. This live operating system cannot be "
+        "used anymore."),
+      _("Press any key to reboot."),
+  };
+  static struct text_layout text;
+  layout->message_width = MESSAGE_WIDTH * scale;
+  layout_text(conn, font, advance, font_height, MESSAGE_LINE_SPACING * scale,
+              strings, (reboot_when_removed ? 2 : 1),
+              layout->message_width - 2 * MESSAGE_MARGIN * scale, &text);
+  layout->message_height = text.height + MESSAGE_BOTTOM_MARGIN * scale;
   xcb_create_pixmap(conn, root_screen->root_depth, pixmap, window,
-                    *message_width, *message_height);
+                    layout->message_width, layout->message_height);
   xcb_create_gc(conn, pixmap_gc, pixmap, 0, 0);
-  xcb_change_gc(conn, pixmap_gc, XCB_GC_FONT, (uint32_t[]){font});
-  xcb_change_gc(conn, pixmap_gc, XCB_GC_FOREGROUND, (uint32_t[]){background});
 
-  xcb_rectangle_t border = {0, 0, *message_width, *message_height};
-  xcb_poly_fill_rectangle(conn, pixmap, pixmap_gc, 1, &border);
+  if (font == XCB_NONE) {
+    struct client_image image;
+    if (!create_client_image(conn, root_screen->root_depth,
+                             layout->message_width, layout->message_height,
+                             &image)) {
+      errx(EXIT_FAILURE, "Cannot render the built-in font at depth %d",
+           root_screen->root_depth);
+    }
+    fill_client_image(&image, 0, 0, image.width, image.height, background);
+    draw_bitmap_text(&image, &text, scale, MESSAGE_MARGIN * scale, 0,
+                     foreground);
+    upload_image(conn, pixmap, pixmap_gc, &image, 0, 0);
+    destroy_client_image(conn, &image);
+  } else {
+    xcb_change_gc(conn, pixmap_gc, XCB_GC_FONT, (uint32_t[]){font});
+    xcb_change_gc(conn, pixmap_gc, XCB_GC_FOREGROUND,
+                  (uint32_t[]){background});
 
-  xcb_change_gc(conn, pixmap_gc, XCB_GC_FOREGROUND, (uint32_t[]){foreground});
-  xcb_change_gc(conn, pixmap_gc, XCB_GC_BACKGROUND, (uint32_t[]){background});
+    xcb_rectangle_t border = {0, 0, layout->message_width,
+                              layout->message_height};
+    xcb_poly_fill_rectangle(conn, pixmap, pixmap_gc, 1, &border);
 
-  int real_strlen;
-  xcb_char2b_t *converted = (xcb_char2b_t *)utf8_to_ucs2(
-      _("The root file system vanished. This live operating system cannot be "
-        "used anymore."),
-      &real_strlen);
-  xcb_image_text_16(conn, real_strlen, pixmap, pixmap_gc, 20 /* X */,
-                    font_height + 2 /* Y = baseline of font */, converted);
-  free(converted);
-  if (reboot_when_removed) {
-    converted = (xcb_char2b_t *)utf8_to_ucs2(_("Press any key to reboot."),
-                                             &real_strlen);
-    xcb_image_text_16(conn, real_strlen, pixmap, pixmap_gc, 20 /* X */,
-                      2 * (font_height + 2) /* Y = baseline of font */,
-                      converted);
-    free(converted);
+    xcb_change_gc(conn, pixmap_gc, XCB_GC_FOREGROUND,
+                  (uint32_t[]){foreground});
+    xcb_change_gc(conn, pixmap_gc, XCB_GC_BACKGROUND,
+                  (uint32_t[]){background});
+
+    draw_text_layout(conn, pixmap, pixmap_gc, &text, MESSAGE_MARGIN, 0);
   }
+
+  const xcb_pixmap_t screen_pixmap = xcb_generate_id(conn);
+  xcb_generic_error_t *error = xcb_request_check(
+      conn, xcb_create_pixmap_checked(conn, root_screen->root_depth,
+                                      screen_pixmap, window, screen_width,
+                                      screen_height));
+  if (error != NULL) {
+    warnx("Could not create %dx%d pixmap (X11 error code %d), will copy the "
+          "message on each expose",
+          screen_width, screen_height, error->error_code);
+    free(error);
+    return false;
+  }
+  /* Areas not covered by any output are never visible, but must not show
+   * uninitialized pixmap contents either. */
+  xcb_change_gc(conn, pixmap_gc, XCB_GC_FOREGROUND, (uint32_t[]){background});
+  xcb_poly_fill_rectangle(
+      conn, screen_pixmap, pixmap_gc, 1,
+      &(xcb_rectangle_t){0, 0, screen_width, screen_height});
+  copy_message_tiles(conn, pixmap, screen_pixmap, pixmap_gc, layout);
+  xcb_change_window_attributes(conn, window, XCB_CW_BACK_PIXMAP,
+                               (uint32_t[]){screen_pixmap});
+  /* The window keeps its background alive. */
+  xcb_free_pixmap(conn, screen_pixmap);
+  return true;
 }
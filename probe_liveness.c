@@ -0,0 +1,113 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <err.h>
+
+#include "blockdev.h"
+#include "watchset.h"
+#include "probe_liveness.h"
+
+/* States of a SCSI device (see scsi_sysfs.c) in which it will not complete
+ * any I/O again. */
+static const char *dead_states[] = {"offline", "transport-offline", "cancel",
+                                    "deleted"};
+
+/*
+ * Opens the sysfs files probe_liveness() reads for every block device in ws.
+ * The first device path of a block device is the block device itself; its
+ * device/state is found next to it (whole disk) or one level up (partition).
+ *
+ */
+void liveness_probe_open(struct liveness_probe *probe,
+                         const struct watchset *ws) {
+  probe->num_fds = 0;
+  if ((probe->fds = calloc(ws->num_blockdevs, sizeof(probe->fds[0]))) ==
+          NULL &&
+      ws->num_blockdevs > 0) {
+    err(EXIT_FAILURE, "calloc");
+  }
+
+  char path[PATH_MAX];
+  for (int i = 0; i < ws->num_blockdevs; i++) {
+    const struct blockdev *blockdev = &ws->blockdevs[i];
+    if (blockdev->num_devpaths == 0) {
+      continue;
+    }
+    snprintf(path, sizeof(path), "/sys%s/stat", blockdev->devpaths[0]);
+    const int stat_fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (stat_fd == -1) {
+      warn("open(%s), not probing \"%s\"", path, blockdev->name);
+      continue;
+    }
+    snprintf(path, sizeof(path), "/sys%s/device/state", blockdev->devpaths[0]);
+    int state_fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (state_fd == -1) {
+      snprintf(path, sizeof(path), "/sys%s/../device/state",
+               blockdev->devpaths[0]);
+      state_fd = open(path, O_RDONLY | O_CLOEXEC);
+    }
+    probe->fds[probe->num_fds++] = (struct liveness_probe_fds){
+        .blockdev = blockdev, .stat_fd = stat_fd, .state_fd = state_fd};
+  }
+}
+
+/*
+ * Reads the files opened by liveness_probe_open() and returns the first block
+ * device which is gone (sysfs answers ENODEV for files of deleted devices,
+ * even when they were opened before) or whose SCSI device is dead. Returns
+ * NULL if all of them are alive. This catches removals whose uevent never
+ * arrived, e.g. because udev was restarting or the stick failed electrically.
+ *
+ */
+const struct blockdev *probe_liveness(const struct liveness_probe *probe) {
+  char buf[256];
+  for (int i = 0; i < probe->num_fds; i++) {
+    const struct liveness_probe_fds *fds = &probe->fds[i];
+    if (pread(fds->stat_fd, buf, sizeof(buf), 0) == -1 && errno == ENODEV) {
+      printf("Block device \"%s\" is gone from sysfs\n", fds->blockdev->name);
+      return fds->blockdev;
+    }
+    if (fds->state_fd == -1) {
+      continue;
+    }
+    const ssize_t n = pread(fds->state_fd, buf, sizeof(buf) - 1, 0);
+    if (n == -1) {
+      if (errno == ENODEV) {
+        printf("SCSI device of \"%s\" is gone from sysfs\n",
+               fds->blockdev->name);
+        return fds->blockdev;
+      }
+      continue;
+    }
+    buf[n] = '\0';
+    buf[strcspn(buf, "\n")] = '\0';
+    for (size_t s = 0; s < sizeof(dead_states) / sizeof(dead_states[0]); s++) {
+      if (strcmp(buf, dead_states[s]) == 0) {
+        printf("SCSI device of \"%s\" is %s\n", fds->blockdev->name, buf);
+        return fds->blockdev;
+      }
+    }
+  }
+  return NULL;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+/* File descriptors read by probe_liveness(), one entry per watched block
+ * device. Opened by liveness_probe_open() while the devices are present. */
+struct liveness_probe {
+  struct liveness_probe_fds {
+    const struct blockdev *blockdev;
+    /* /sys/…/stat of the block device */
+    int stat_fd;
+    /* device/state of the SCSI disk, or -1 if there is none */
+    int state_fd;
+  } *fds;
+  int num_fds;
+};
+
+void liveness_probe_open(struct liveness_probe *probe,
+                         const struct watchset *ws);
+const struct blockdev *probe_liveness(const struct liveness_probe *probe);
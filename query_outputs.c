@@ -0,0 +1,142 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <err.h>
+#include <xcb/xcb.h>
+#include <xcb/randr.h>
+
+/* Assumed when the physical size of a screen is unknown */
+#define DEFAULT_DPI 96
+
+/*
+ * Dots per inch of pixels spread over mm millimeters, or 0 if mm is 0 (which
+ * is what X servers report for projectors and many virtual displays).
+ *
+ */
+static int dpi(int pixels, int mm) {
+  return (mm > 0 ? (pixels * 254 + mm * 5) / (mm * 10) : 0);
+}
+
+/*
+ * Stores the area of each active CRTC (i.e. each monitor, except that cloned
+ * outputs share a CRTC) in outputs and returns their number. All CRTCs, then
+ * all of their outputs, are queried in one batch each. Without RandR, the
+ * whole screen is the only output.
+ *
+ * The highest resolution of any output (in dots per inch, going by the
+ * physical size of its first connected output) is stored in max_dpi. Without
+ * RandR, the physical size of the screen is used instead.
+ *
+ */
+int query_outputs(xcb_connection_t *conn, const xcb_screen_t *root_screen,
+                  xcb_rectangle_t *outputs, int max_outputs, int *max_dpi) {
+  int num_outputs = 0;
+  *max_dpi = 0;
+  const xcb_query_extension_reply_t *extension =
+      xcb_get_extension_data(conn, &xcb_randr_id);
+  xcb_randr_get_screen_resources_current_reply_t *resources = NULL;
+  if (extension != NULL && extension->present) {
+    resources = xcb_randr_get_screen_resources_current_reply(
+        conn, xcb_randr_get_screen_resources_current(conn, root_screen->root),
+        NULL);
+  }
+  if (resources != NULL) {
+    const xcb_randr_crtc_t *crtcs =
+        xcb_randr_get_screen_resources_current_crtcs(resources);
+    const int num_crtcs =
+        xcb_randr_get_screen_resources_current_crtcs_length(resources);
+    xcb_randr_get_crtc_info_cookie_t *cookies =
+        calloc(num_crtcs, sizeof(xcb_randr_get_crtc_info_cookie_t));
+    if (cookies == NULL && num_crtcs > 0) {
+      err(EXIT_FAILURE, "calloc");
+    }
+    for (int i = 0; i < num_crtcs; i++) {
+      cookies[i] =
+          xcb_randr_get_crtc_info(conn, crtcs[i], resources->config_timestamp);
+    }
+    xcb_randr_get_output_info_cookie_t *output_cookies =
+        calloc(num_crtcs, sizeof(xcb_randr_get_output_info_cookie_t));
+    /* The longer side of each CRTC, to compare with the (unrotated) physical
+     * size of its output */
+    int *crtc_pixels = calloc(num_crtcs, sizeof(int));
+    if ((output_cookies == NULL || crtc_pixels == NULL) && num_crtcs > 0) {
+      err(EXIT_FAILURE, "calloc");
+    }
+    for (int i = 0; i < num_crtcs; i++) {
+      xcb_randr_get_crtc_info_reply_t *crtc =
+          xcb_randr_get_crtc_info_reply(conn, cookies[i], NULL);
+      if (crtc == NULL) {
+        continue;
+      }
+      const xcb_rectangle_t area = {crtc->x, crtc->y, crtc->width,
+                                    crtc->height};
+      if (area.width > 0 && area.height > 0 &&
+          xcb_randr_get_crtc_info_outputs_length(crtc) > 0) {
+        output_cookies[i] = xcb_randr_get_output_info(
+            conn, xcb_randr_get_crtc_info_outputs(crtc)[0],
+            resources->config_timestamp);
+        crtc_pixels[i] = (area.width > area.height ? area.width : area.height);
+      }
+      free(crtc);
+      if (area.width == 0 || area.height == 0 || num_outputs == max_outputs) {
+        continue;
+      }
+      bool duplicate = false;
+      for (int j = 0; j < num_outputs; j++) {
+        duplicate |= (memcmp(&outputs[j], &area, sizeof(area)) == 0);
+      }
+      if (!duplicate) {
+        outputs[num_outputs++] = area;
+      }
+    }
+    for (int i = 0; i < num_crtcs; i++) {
+      if (crtc_pixels[i] == 0) {
+        continue;
+      }
+      xcb_randr_get_output_info_reply_t *output =
+          xcb_randr_get_output_info_reply(conn, output_cookies[i], NULL);
+      if (output == NULL) {
+        continue;
+      }
+      const int mm = (output->mm_width > output->mm_height ? output->mm_width
+                                                           : output->mm_height);
+      const int output_dpi = dpi(crtc_pixels[i], mm);
+      if (output_dpi > *max_dpi) {
+        *max_dpi = output_dpi;
+      }
+      free(output);
+    }
+    free(crtc_pixels);
+    free(output_cookies);
+    free(cookies);
+    free(resources);
+  }
+
+  if (num_outputs == 0) {
+    outputs[num_outputs++] = (xcb_rectangle_t){
+        0, 0, root_screen->width_in_pixels, root_screen->height_in_pixels};
+  }
+  if (*max_dpi == 0) {
+    *max_dpi = dpi(root_screen->width_in_pixels,
+                   root_screen->width_in_millimeters);
+  }
+  if (*max_dpi == 0) {
+    *max_dpi = DEFAULT_DPI;
+  }
+  return num_outputs;
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+int query_outputs(xcb_connection_t *conn, const xcb_screen_t *root_screen,
+                  xcb_rectangle_t *outputs, int max_outputs, int *max_dpi);
@@ -16,12 +16,146 @@
 #include <dbus/dbus.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
 #include <err.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <linux/reboot.h>
+
+#include "monotonic_ms.h"
+#include "reboot.h"
+
+/* Delay between the sysrq sync, remount read-only and reboot requests. The
+ * kernel processes the first two asynchronously. */
+#define SYSRQ_STEP_MS 500
+
+/* Serials of the messages sent behind libdbus' back. libdbus counts up from 1,
+ * so these do not collide with the ones it assigns itself. */
+#define REBOOT_SERIAL 0x7fffffff
+#define PING_SERIAL 0x7ffffffe
+
+/* The escalation ladder, see reboot_prepare(). */
+static enum reboot_method methods[MAX_REBOOT_METHODS];
+static int num_methods;
+static int logind_timeout_ms;
 
 static DBusConnection *conn;
-static DBusMessage *msg;
+static int conn_fd = -1;
+/* The Reboot(true) call, marshalled by reboot_prepare() */
+static char *reboot_buf;
+static int reboot_len;
+/* /proc/sysrq-trigger, or -1 if it could not be opened */
+static int sysrq_fd = -1;
 
-void reboot_prepare(void) {
+static DBusMessage *new_login1_call(const char *interface, const char *method,
+                                    dbus_uint32_t serial) {
+  DBusMessage *msg;
+  if ((msg = dbus_message_new_method_call(
+           "org.freedesktop.login1", "/org/freedesktop/login1", interface,
+           method)) == NULL) {
+    errx(EXIT_FAILURE, "dbus_message_new_method_call failed");
+  }
+  dbus_message_set_serial(msg, serial);
+  return msg;
+}
+
+static void marshal(DBusMessage *msg, char **buf, int *len) {
+  if (!dbus_message_marshal(msg, buf, len)) {
+    errx(EXIT_FAILURE, "dbus_message_marshal failed");
+  }
+  dbus_message_unref(msg);
+}
+
+/*
+ * Writes the marshalled method call in buf to the bus socket and waits at
+ * most timeout_ms for the reply to serial. Only the reply is parsed by libdbus,
+ * the call itself goes out with a single send(). Returns true if the call
+ * succeeded.
+ *
+ */
+static bool call_raw(const char *buf, int len, dbus_uint32_t serial,
+                     int timeout_ms) {
+  const ssize_t n = send(conn_fd, buf, len, MSG_DONTWAIT | MSG_NOSIGNAL);
+  if (n != len) {
+    if (n == -1)
+      warn("send(dbus)");
+    else
+      warnx("send(dbus): short write (%zd of %d bytes)", n, len);
+    return false;
+  }
+
+  const int64_t deadline_ms = monotonic_ms() + timeout_ms;
+  for (;;) {
+    DBusMessage *reply;
+    dbus_connection_read_write(conn, 0);
+    while ((reply = dbus_connection_pop_message(conn)) != NULL) {
+      if (dbus_message_get_reply_serial(reply) != serial) {
+        dbus_message_unref(reply);
+        continue;
+      }
+      const bool ok =
+          (dbus_message_get_type(reply) == DBUS_MESSAGE_TYPE_METHOD_RETURN);
+      if (!ok) {
+        const char *message = NULL;
+        dbus_message_get_args(reply, NULL, DBUS_TYPE_STRING, &message,
+                              DBUS_TYPE_INVALID);
+        warnx("dbus: %s: %s", dbus_message_get_error_name(reply),
+              (message != NULL ? message : ""));
+      }
+      dbus_message_unref(reply);
+      return ok;
+    }
+    if (!dbus_connection_get_is_connected(conn)) {
+      warnx("dbus: connection closed");
+      return false;
+    }
+
+    const int64_t remaining = deadline_ms - monotonic_ms();
+    if (remaining <= 0) {
+      warnx("dbus: no reply within %d ms", timeout_ms);
+      return false;
+    }
+    struct pollfd pfd = {.fd = conn_fd, .events = POLLIN};
+    if (poll(&pfd, 1, (int)remaining) == -1 && errno != EINTR) {
+      warn("poll(dbus)");
+      return false;
+    }
+  }
+}
+
+static void parse_methods(const char *list) {
+  char *copy = strdup(list);
+  if (copy == NULL)
+    err(EXIT_FAILURE, "strdup");
+  char *saveptr = NULL;
+  for (char *name = strtok_r(copy, ",", &saveptr); name != NULL;
+       name = strtok_r(NULL, ",", &saveptr)) {
+    enum reboot_method method;
+    if (strcmp(name, "logind") == 0) {
+      method = REBOOT_METHOD_LOGIND;
+    } else if (strcmp(name, "syscall") == 0) {
+      method = REBOOT_METHOD_SYSCALL;
+    } else if (strcmp(name, "sysrq") == 0) {
+      method = REBOOT_METHOD_SYSRQ;
+    } else {
+      errx(EXIT_FAILURE, "Unknown --reboot_methods entry \"%s\"", name);
+    }
+    if (num_methods == MAX_REBOOT_METHODS)
+      errx(EXIT_FAILURE, "Too many --reboot_methods entries");
+    methods[num_methods++] = method;
+  }
+  free(copy);
+  if (num_methods == 0)
+    errx(EXIT_FAILURE, "--reboot_methods is empty");
+}
+
+static void prepare_logind(void) {
   DBusError err;
   dbus_error_init(&err);
   conn = dbus_bus_get(DBUS_BUS_SYSTEM, &err);
@@ -29,26 +163,110 @@ void reboot_prepare(void) {
     errx(EXIT_FAILURE, "Could not connect to system dbus (for --reboot): %s",
          err.message);
   }
-
-  if ((msg = dbus_message_new_method_call(
-           "org.freedesktop.login1", "/org/freedesktop/login1",
-           "org.freedesktop.login1.Manager", "Reboot")) == NULL) {
-    errx(EXIT_FAILURE, "dbus_message_new_method_call failed");
+  /* Deal with a dying bus in reboot() instead of calling _exit() */
+  dbus_connection_set_exit_on_disconnect(conn, FALSE);
+  dbus_connection_flush(conn);
+  if (!dbus_connection_get_socket(conn, &conn_fd)) {
+    errx(EXIT_FAILURE, "dbus_connection_get_socket failed");
   }
 
+  DBusMessage *msg = new_login1_call("org.freedesktop.login1.Manager",
+                                     "Reboot", REBOOT_SERIAL);
   DBusMessageIter args;
   dbus_message_iter_init_append(msg, &args);
   const dbus_bool_t param = TRUE;
   if (!dbus_message_iter_append_basic(&args, DBUS_TYPE_BOOLEAN, &param)) {
     errx(EXIT_FAILURE, "dbus_message_iter_append_basic failed");
   }
+  marshal(msg, &reboot_buf, &reboot_len);
+}
+
+/*
+ * Prepares the reboot methods in the comma-separated list (in this order):
+ * "logind" calls logind's Reboot method and waits at most timeout_ms for the
+ * reply, "syscall" calls reboot(2), "sysrq" requests an emergency sync, a
+ * read-only remount and a reboot via /proc/sysrq-trigger. The latter two only
+ * work as root.
+ *
+ * Everything reboot() needs (bus connection, marshalled message, file
+ * descriptors) is set up here, so that the escalation does not touch the
+ * vanished root file system or allocate memory.
+ *
+ */
+void reboot_prepare(const char *list, int timeout_ms) {
+  parse_methods(list);
+  logind_timeout_ms = timeout_ms;
+
+  for (int i = 0; i < num_methods; i++) {
+    if (methods[i] == REBOOT_METHOD_LOGIND && conn == NULL) {
+      prepare_logind();
+    } else if (methods[i] == REBOOT_METHOD_SYSRQ && sysrq_fd == -1) {
+      if ((sysrq_fd = open("/proc/sysrq-trigger", O_WRONLY | O_CLOEXEC)) ==
+          -1) {
+        warn("open(/proc/sysrq-trigger), not using it to reboot");
+      }
+    }
+  }
+}
+
+static void sysrq(char c) {
+  if (write(sysrq_fd, &c, 1) == -1) {
+    warn("write(/proc/sysrq-trigger, %c)", c);
+  }
 }
 
+/*
+ * Tries the reboot methods passed to reboot_prepare() one after the other.
+ * Returns once logind accepted the Reboot call; the other methods do not
+ * return if they succeed.
+ *
+ */
 void reboot(void) {
-  DBusError error;
-  dbus_error_init(&error);
-  dbus_connection_send_with_reply_and_block(conn, msg, -1, &error);
-  if (dbus_error_is_set(&error)) {
-    errx(EXIT_FAILURE, "dbus: %s: %s", error.name, error.message);
+  for (int i = 0; i < num_methods; i++) {
+    switch (methods[i]) {
+    case REBOOT_METHOD_LOGIND:
+      if (call_raw(reboot_buf, reboot_len, REBOOT_SERIAL, logind_timeout_ms)) {
+        return;
+      }
+      warnx("logind did not reboot");
+      break;
+
+    case REBOOT_METHOD_SYSCALL:
+      /* LINUX_REBOOT_CMD_RESTART is what glibc calls RB_AUTOBOOT. */
+      if (syscall(SYS_reboot, LINUX_REBOOT_MAGIC1, LINUX_REBOOT_MAGIC2,
+                  LINUX_REBOOT_CMD_RESTART, NULL) == -1) {
+        warn("reboot(2)");
+      }
+      break;
+
+    case REBOOT_METHOD_SYSRQ:
+      if (sysrq_fd == -1) {
+        break;
+      }
+      sysrq('s');
+      poll(NULL, 0, SYSRQ_STEP_MS);
+      sysrq('u');
+      poll(NULL, 0, SYSRQ_STEP_MS);
+      sysrq('b');
+      break;
+    }
+  }
+  errx(EXIT_FAILURE, "Could not reboot");
+}
+
+/*
+ * Sends a harmless Ping to logind through the same code path reboot() uses, so
+ * that the pages involved end up in the page list (see mlock_record()).
+ *
+ */
+void reboot_rehearse(void) {
+  if (conn == NULL) {
+    return;
   }
+  char *buf;
+  int len;
+  marshal(new_login1_call("org.freedesktop.DBus.Peer", "Ping", PING_SERIAL),
+          &buf, &len);
+  call_raw(buf, len, PING_SERIAL, logind_timeout_ms);
+  dbus_free(buf);
 }
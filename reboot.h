@@ -1,4 +1,13 @@
 #pragma once
 
-void reboot_prepare(void);
+/* The steps reboot() escalates through, see reboot_prepare(). */
+enum reboot_method {
+  REBOOT_METHOD_LOGIND,
+  REBOOT_METHOD_SYSCALL,
+  REBOOT_METHOD_SYSRQ,
+};
+#define MAX_REBOOT_METHODS 8
+
+void reboot_prepare(const char *list, int timeout_ms);
 void reboot(void);
+void reboot_rehearse(void);
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <err.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+
+extern char **environ;
+
+/*
+ * Returns whether the running executable is a memfd, i.e. whether
+ * reexec_from_memfd() already happened.
+ *
+ */
+bool running_from_memfd(void) {
+  char exe[PATH_MAX];
+  const ssize_t len = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+  if (len == -1) {
+    return false;
+  }
+  exe[len] = '\0';
+  return strncmp(exe, "/memfd:", strlen("/memfd:")) == 0;
+}
+
+/*
+ * Copies the running executable into an anonymous memfd and executes that
+ * instead, so that the program text is not backed by the root file system.
+ * Returns (only) if that already happened.
+ *
+ */
+void reexec_from_memfd(char *argv[]) {
+  if (running_from_memfd()) {
+    return;
+  }
+
+  const int exe = open("/proc/self/exe", O_RDONLY | O_CLOEXEC);
+  if (exe == -1) {
+    err(EXIT_FAILURE, "open(/proc/self/exe)");
+  }
+  struct stat st;
+  if (fstat(exe, &st) == -1) {
+    err(EXIT_FAILURE, "fstat(/proc/self/exe)");
+  }
+  const int memfd = memfd_create("root-vanished", MFD_CLOEXEC);
+  if (memfd == -1) {
+    err(EXIT_FAILURE, "memfd_create");
+  }
+  off_t offset = 0;
+  while (offset < st.st_size) {
+    const ssize_t n = sendfile(memfd, exe, &offset, st.st_size - offset);
+    if (n == -1) {
+      err(EXIT_FAILURE, "sendfile");
+    }
+    if (n == 0) {
+      errx(EXIT_FAILURE, "/proc/self/exe shrunk to %lld bytes while copying",
+           (long long int)offset);
+    }
+  }
+  close(exe);
+
+  printf("Re-executing from memfd\n");
+  fflush(stdout);
+  fexecve(memfd, argv, environ);
+  err(EXIT_FAILURE, "fexecve");
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+bool running_from_memfd(void);
+void reexec_from_memfd(char *argv[]);
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdio.h>
+#include <stdbool.h>
+#include <err.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+
+#include "blockdev.h"
+
+/* Bounds the recursion through stacked devices (dm on loop on partition …). */
+#define MAX_STACK_DEPTH 8
+
+static void add_devpath(struct blockdev *blockdev, const char *devpath) {
+  for (int i = 0; i < blockdev->num_devpaths; i++) {
+    if (strcmp(blockdev->devpaths[i], devpath) == 0) {
+      return;
+    }
+  }
+  blockdev->devpaths =
+      realloc(blockdev->devpaths,
+              (blockdev->num_devpaths + 1) * sizeof(blockdev->devpaths[0]));
+  if (blockdev->devpaths == NULL) {
+    err(EXIT_FAILURE, "realloc");
+  }
+  if ((blockdev->devpaths[blockdev->num_devpaths] = strdup(devpath)) == NULL) {
+    err(EXIT_FAILURE, "strdup");
+  }
+  blockdev->num_devpaths++;
+}
+
+/*
+ * Reads the first line of the given sysfs attribute into buf, without the
+ * trailing newline. Returns false if the attribute cannot be read.
+ *
+ */
+static bool read_attribute(const char *path, char *buf, size_t size) {
+  FILE *f = fopen(path, "r");
+  if (f == NULL) {
+    return false;
+  }
+  const bool ok = (fgets(buf, size, f) != NULL);
+  fclose(f);
+  if (ok) {
+    buf[strcspn(buf, "\n")] = '\0';
+  }
+  return ok;
+}
+
+static void add_ancestry(struct blockdev *blockdev, dev_t devnum, int depth) {
+  if (depth > MAX_STACK_DEPTH) {
+    warnx("Not following block devices stacked deeper than %d levels",
+          MAX_STACK_DEPTH);
+    return;
+  }
+
+  char path[PATH_MAX + 32];
+  snprintf(path, sizeof(path), "/sys/dev/block/%u:%u", major(devnum),
+           minor(devnum));
+  char *sysfs_path = realpath(path, NULL);
+  if (sysfs_path == NULL) {
+    warn("realpath(%s)", path);
+    return;
+  }
+
+  /* Every directory on the way up to /sys/devices which has a uevent file is
+   * a device whose removal takes our block device with it: the disk of a
+   * partition, the SCSI device, the USB interface, the USB device, the hub… */
+  char devpath[PATH_MAX];
+  snprintf(devpath, sizeof(devpath), "%s", sysfs_path);
+  while (strlen(devpath) > strlen("/sys/devices")) {
+    snprintf(path, sizeof(path), "%s/uevent", devpath);
+    if (access(path, F_OK) == 0) {
+      add_devpath(blockdev, devpath + strlen("/sys"));
+    }
+    *strrchr(devpath, '/') = '\0';
+  }
+
+  /* Device mapper (dm-crypt, LVM, …) and md list the devices they are stacked
+   * on in slaves/. */
+  snprintf(path, sizeof(path), "%s/slaves", sysfs_path);
+  DIR *dir = opendir(path);
+  if (dir != NULL) {
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+      if (entry->d_name[0] == '.') {
+        continue;
+      }
+      char dev[32];
+      unsigned int maj, min;
+      snprintf(path, sizeof(path), "%s/slaves/%s/dev", sysfs_path,
+               entry->d_name);
+      if (read_attribute(path, dev, sizeof(dev)) &&
+          sscanf(dev, "%u:%u", &maj, &min) == 2) {
+        add_ancestry(blockdev, makedev(maj, min), depth + 1);
+      }
+    }
+    closedir(dir);
+  }
+
+  /* A loop device depends on the file system its backing file is on. */
+  char backing_file[PATH_MAX];
+  snprintf(path, sizeof(path), "%s/loop/backing_file", sysfs_path);
+  if (read_attribute(path, backing_file, sizeof(backing_file))) {
+    struct stat st;
+    if (stat(backing_file, &st) == -1) {
+      warn("stat(%s)", backing_file);
+    } else if (major(st.st_dev) != 0) {
+      /* Major 0 are anonymous devices (tmpfs, overlayfs, …), which have no
+       * representation in /sys/dev/block. */
+      add_ancestry(blockdev, st.st_dev, depth + 1);
+    }
+  }
+
+  free(sysfs_path);
+}
+
+/*
+ * Fills blockdev->devpaths with the devpaths of blockdev, all block devices it
+ * is stacked on (device mapper slaves, loop device backing files) and all of
+ * their parent devices, so that the earliest removal uevent of any of them can
+ * be acted upon. The kernel tears down children last, so e.g. the removal of a
+ * USB stick's interface arrives before the removal of the partition on it.
+ *
+ */
+void resolve_blockdev_ancestry(struct blockdev *blockdev) {
+  add_ancestry(blockdev, blockdev->devnum, 0);
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void resolve_blockdev_ancestry(struct blockdev *blockdev);
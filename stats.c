@@ -0,0 +1,143 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <err.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "monotonic_ms.h"
+#include "stats.h"
+
+struct stats stats;
+
+/*
+ * Starts timing a stage of the startup. Returns the handle to pass to
+ * stats_stage_end(), or -1 (which stats_stage_end() ignores) if
+ * MAX_STATS_STAGES were recorded already.
+ *
+ */
+int stats_stage_begin(const char *name) {
+  if (stats.num_stages == MAX_STATS_STAGES) {
+    return -1;
+  }
+  stats.stages[stats.num_stages] = (struct stats_stage){
+      .name = name, .start_us = monotonic_us(), .end_us = -1};
+  return stats.num_stages++;
+}
+
+void stats_stage_end(int stage) {
+  if (stage != -1) {
+    stats.stages[stage].end_us = monotonic_us();
+  }
+}
+
+/*
+ * Stores the value (in kB) of the given field of /proc/self/status in kib.
+ * Reads into a buffer on the stack, so that dumping the statistics does not
+ * allocate memory.
+ *
+ */
+static void read_status(const char *buf, const char *field,
+                        unsigned long long int *kib) {
+  const char *line = strstr(buf, field);
+  *kib = (line != NULL ? strtoull(line + strlen(field), NULL, 10) : 0);
+}
+
+/*
+ * Prints the counters of stats, the resident and locked memory and how long
+ * each startup stage took. Called on SIGUSR1 and on exit with --stats.
+ *
+ */
+void stats_dump(void) {
+  char buf[4096];
+  ssize_t n = -1;
+  const int fd = open("/proc/self/status", O_RDONLY | O_CLOEXEC);
+  if (fd != -1) {
+    n = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+  }
+  buf[(n > 0 ? n : 0)] = '\0';
+  unsigned long long int rss_kib, locked_kib;
+  read_status(buf, "VmRSS:", &rss_kib);
+  read_status(buf, "VmLck:", &locked_kib);
+
+  printf("Statistics:\n");
+  printf("\twakeups: %llu (liveness probe: %llu)\n",
+         (unsigned long long int)stats.wakeups,
+         (unsigned long long int)stats.probe_wakeups);
+  if (stats.idle_wakeup_interval_ms == 0) {
+    printf("\tidle: no timers, no periodic wakeups\n");
+  } else {
+    printf("\tidle: liveness probe wakes up every %d ms "
+           "(--probe_interval_ms=0 disables it)\n",
+           stats.idle_wakeup_interval_ms);
+  }
+  printf("\tuevents: %llu received, %llu matched\n",
+         (unsigned long long int)stats.uevents_received,
+         (unsigned long long int)stats.uevents_matched);
+  printf("\tmemory: %llu kB resident, %llu kB mlocked\n", rss_kib,
+         locked_kib);
+  for (int i = 0; i < stats.num_stages; i++) {
+    const struct stats_stage *stage = &stats.stages[i];
+    const double started_ms =
+        (stage->start_us - stats.stages[0].start_us) / 1000.0;
+    if (stage->end_us == -1) {
+      printf("\tstage \"%s\": started at +%.3f ms, not finished\n",
+             stage->name, started_ms);
+      continue;
+    }
+    printf("\tstage \"%s\": started at +%.3f ms, took %.3f ms\n",
+           stage->name, started_ms,
+           (stage->end_us - stage->start_us) / 1000.0);
+  }
+  fflush(stdout);
+}
+
+/*
+ * Writes the finished startup stages to path as a Chrome trace (JSON object
+ * format, complete events), which chrome://tracing or Perfetto can display.
+ * Failure is not fatal, the trace is only a diagnostic.
+ *
+ */
+void stats_write_trace(const char *path) {
+  FILE *f = fopen(path, "w");
+  if (f == NULL) {
+    warn("fopen(%s)", path);
+    return;
+  }
+  const int pid = getpid();
+  fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+  const char *sep = "";
+  for (int i = 0; i < stats.num_stages; i++) {
+    const struct stats_stage *stage = &stats.stages[i];
+    if (stage->end_us == -1) {
+      continue;
+    }
+    fprintf(f,
+            "%s\n{\"name\":\"%s\",\"cat\":\"startup\",\"ph\":\"X\","
+            "\"ts\":%lld,\"dur\":%lld,\"pid\":%d,\"tid\":%d}",
+            sep, stage->name, (long long int)stage->start_us,
+            (long long int)(stage->end_us - stage->start_us), pid, pid);
+    sep = ",";
+  }
+  fprintf(f, "\n]}\n");
+  if (fclose(f) != 0) {
+    warn("fclose(%s)", path);
+  }
+}
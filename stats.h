@@ -0,0 +1,33 @@
+#pragma once
+
+/* Maximum number of startup stages recorded by stats_stage_begin() */
+#define MAX_STATS_STAGES 16
+
+/* A timed part of the startup, see stats_stage_begin(). */
+struct stats_stage {
+  const char *name;
+  int64_t start_us;
+  int64_t end_us;
+};
+
+/* Counters for --stats, printed by stats_dump(). */
+struct stats {
+  /* Returns from epoll_wait(), and how many of them were due to the liveness
+   * probe (the only source of periodic wakeups) */
+  uint64_t wakeups;
+  uint64_t probe_wakeups;
+  uint64_t uevents_received;
+  uint64_t uevents_matched;
+  /* Interval of the liveness probe timer, 0 if idle has no periodic
+   * wakeups */
+  int idle_wakeup_interval_ms;
+  struct stats_stage stages[MAX_STATS_STAGES];
+  int num_stages;
+};
+
+extern struct stats stats;
+
+int stats_stage_begin(const char *name);
+void stats_stage_end(int stage);
+void stats_dump(void);
+void stats_write_trace(const char *path);
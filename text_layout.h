@@ -0,0 +1,24 @@
+#pragma once
+
+/* Limits of the text which fits into a message, see layout_text() */
+#define MAX_TEXT_CHARS 1024
+#define MAX_TEXT_RUNS 32
+#define MAX_TEXT_WORDS 256
+
+/* One line of text: chars[offset] to chars[offset + len - 1], drawn with its
+ * baseline at y (relative to the top of the text). */
+struct text_run {
+  uint16_t offset;
+  uint16_t len;
+  int16_t y;
+};
+
+/* Word-wrapped text, ready to be drawn with xcb_image_text_16(). */
+struct text_layout {
+  xcb_char2b_t chars[MAX_TEXT_CHARS];
+  int num_chars;
+  struct text_run runs[MAX_TEXT_RUNS];
+  int num_runs;
+  /* Distance from the top of the text to the bottom of the last line */
+  int height;
+};
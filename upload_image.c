@@ -0,0 +1,69 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <err.h>
+#include <xcb/xcb.h>
+#include <xcb/shm.h>
+
+#include "client_image.h"
+#include "upload_image.h"
+
+/*
+ * Copies image to (x, y) of drawable. An image in shared memory takes a single
+ * ShmPutImage request, which is waited for so that the image can be destroyed
+ * right afterwards. Otherwise, or if that fails, the pixels are sent with as
+ * many PutImage requests as the maximum request length of the connection
+ * requires.
+ *
+ */
+void upload_image(xcb_connection_t *conn, xcb_drawable_t drawable,
+                  xcb_gcontext_t gc, const struct client_image *image,
+                  int16_t x, int16_t y) {
+  if (image->shmseg != 0) {
+    xcb_generic_error_t *error = xcb_request_check(
+        conn, xcb_shm_put_image_checked(
+                  conn, drawable, gc, image->width, image->height, 0, 0,
+                  image->width, image->height, x, y, image->depth,
+                  XCB_IMAGE_FORMAT_Z_PIXMAP, 0, image->shmseg, 0));
+    if (error == NULL) {
+      return;
+    }
+    warnx("ShmPutImage failed (X11 error code %d), sending the image instead",
+          error->error_code);
+    free(error);
+  }
+
+  /* The maximum request length is in units of 4 bytes and includes the
+   * request header. */
+  const uint32_t max_bytes = xcb_get_maximum_request_length(conn) * 4 -
+                             sizeof(xcb_put_image_request_t);
+  const uint32_t rows_per_request = max_bytes / image->stride;
+  if (rows_per_request == 0) {
+    errx(EXIT_FAILURE, "Image rows of %d bytes exceed the X11 request size",
+         image->stride);
+  }
+
+  for (uint32_t row = 0; row < image->height; row += rows_per_request) {
+    const uint32_t rows = (image->height - row < rows_per_request
+                               ? image->height - row
+                               : rows_per_request);
+    xcb_put_image(conn, XCB_IMAGE_FORMAT_Z_PIXMAP, drawable, gc, image->width,
+                  rows, x, y + row, 0, image->depth, rows * image->stride,
+                  image->data + row * image->stride);
+  }
+}
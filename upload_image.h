@@ -0,0 +1,5 @@
+#pragma once
+
+void upload_image(xcb_connection_t *conn, xcb_drawable_t drawable,
+                  xcb_gcontext_t gc, const struct client_image *image,
+                  int16_t x, int16_t y);
@@ -13,54 +13,93 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include <stdlib.h>
-#include <stdio.h>
+#include <stdint.h>
 #include <string.h>
-#include <err.h>
-#include <iconv.h>
+#include <xcb/xcb.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
-static iconv_t conversion_descriptor = (iconv_t)-1;
+#include "utf8_to_ucs2.h"
+
+/* Length of a UTF-8 sequence, indexed by the upper 5 bits of its first byte.
+ * 0 for continuation bytes and 0xF8..0xFF, which cannot start a sequence. */
+static const uint8_t sequence_length[32] = {
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, /* 0x00..0x7F */
+    0, 0, 0, 0, 0, 0, 0, 0,                         /* 0x80..0xBF */
+    2, 2, 2, 2,                                     /* 0xC0..0xDF */
+    3, 3,                                           /* 0xE0..0xEF */
+    4,                                              /* 0xF0..0xF7 */
+    0,                                              /* 0xF8..0xFF */
+};
+
+/* Payload bits of the first byte and smallest code point which needs a
+ * sequence of this length (anything below is an overlong encoding). */
+static const uint8_t lead_mask[5] = {0, 0x7F, 0x1F, 0x0F, 0x07};
+static const uint32_t min_code_point[5] = {0, 0, 0x80, 0x800, 0x10000};
+
+#define REPLACEMENT_CHARACTER 0xFFFD
 
 /*
- * Converts the given string to UCS-2 big endian for use with
- * xcb_image_text_16(). The amount of real glyphs is stored in real_strlen,
- * a buffer containing the UCS-2 encoded string (16 bit per glyph) is
- * returned. It has to be freed when done.
+ * Decodes one UTF-8 sequence at *in and advances *in past it. Invalid
+ * sequences and code points which UCS-2 cannot represent (surrogates, anything
+ * outside the Basic Multilingual Plane) are returned as U+FFFD. Never reads
+ * past the terminating NUL byte.
  *
  */
-char *utf8_to_ucs2(char *input, int *real_strlen) {
-  size_t input_size = strlen(input) + 1;
-  /* UCS-2 consumes exactly two bytes for each glyph */
-  int buffer_size = input_size * 2;
-
-  char *buffer = malloc(buffer_size);
-  if (buffer == NULL) {
-    err(EXIT_FAILURE, "malloc(%d)", buffer_size);
+static uint16_t decode(const uint8_t **in) {
+  const uint8_t *p = *in;
+  const int len = sequence_length[p[0] >> 3];
+  uint32_t c = p[0] & lead_mask[len];
+  int i;
+  for (i = 1; i < len && (p[i] & 0xC0) == 0x80; i++) {
+    c = (c << 6) | (p[i] & 0x3F);
   }
-  size_t output_size = buffer_size;
-  /* We need to use an additional pointer, because iconv() modifies it */
-  char *output = buffer;
-
-  /* We convert the input into UCS-2 big endian */
-  if (conversion_descriptor == (iconv_t)-1) {
-    if ((conversion_descriptor = iconv_open("UCS-2BE", "UTF-8")) ==
-        (iconv_t)-1) {
-      err(EXIT_FAILURE, "icon_open(UCS-2BE, UTF-8)");
-    }
+  *in = p + (i > 1 ? i : 1);
+  if (len == 0 || i < len || c < min_code_point[len] || c > 0xFFFF ||
+      (c >= 0xD800 && c <= 0xDFFF)) {
+    return REPLACEMENT_CHARACTER;
   }
+  return c;
+}
 
-  /* Get the conversion descriptor back to original state */
-  iconv(conversion_descriptor, NULL, NULL, NULL, NULL);
-
-  /* Convert our text */
-  if (iconv(conversion_descriptor, (void *)&input, &input_size, &output,
-            &output_size) == (size_t)-1) {
-    err(EXIT_FAILURE, "iconv()");
-  }
+/*
+ * Converts the given string to UCS-2 big endian for use with
+ * xcb_image_text_16(), writing at most max_chars characters to output.
+ * Returns the number of characters the whole string converts to, like
+ * snprintf() does, so a return value above max_chars means truncation.
+ *
+ * This neither allocates memory nor loads iconv modules from disk.
+ *
+ */
+int utf8_to_ucs2(const char *input, xcb_char2b_t *output, int max_chars) {
+  const uint8_t *in = (const uint8_t *)input;
+  const uint8_t *end = in + strlen(input);
+  int n = 0;
 
-  if (real_strlen != NULL) {
-    *real_strlen = ((buffer_size - output_size) / 2) - 1;
+  while (in < end) {
+#ifdef __SSE2__
+    /* Widen runs of 16 ASCII characters with two stores, by interleaving
+     * them with zero bytes (the high byte comes first). */
+    if (end - in >= 16 && max_chars - n >= 16) {
+      const __m128i bytes = _mm_loadu_si128((const __m128i *)in);
+      if (_mm_movemask_epi8(bytes) == 0) {
+        const __m128i zero = _mm_setzero_si128();
+        _mm_storeu_si128((__m128i *)&output[n],
+                         _mm_unpacklo_epi8(zero, bytes));
+        _mm_storeu_si128((__m128i *)&output[n + 8],
+                         _mm_unpackhi_epi8(zero, bytes));
+        in += 16;
+        n += 16;
+        continue;
+      }
+    }
+#endif
+    const uint16_t c = (in[0] < 0x80 ? *in++ : decode(&in));
+    if (n < max_chars) {
+      output[n] = (xcb_char2b_t){.byte1 = c >> 8, .byte2 = c & 0xFF};
+    }
+    n++;
   }
-
-  return buffer;
+  return n;
 }
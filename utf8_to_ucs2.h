@@ -1,3 +1,3 @@
 #pragma once
 
-char *utf8_to_ucs2(char *input, int *real_strlen);
+int utf8_to_ucs2(const char *input, xcb_char2b_t *output, int max_chars);
@@ -14,56 +14,339 @@
  * limitations under the License.
  */
 #include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <err.h>
+#include <errno.h>
+#include <limits.h>
 
-#include <sys/poll.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <sys/types.h>
+#include <sys/sysmacros.h>
 #include <unistd.h>
 
 #include <linux/types.h>
 #include <linux/netlink.h>
+#include <linux/filter.h>
 
-void wait_for_blockdev_removal(const char *blockdev) {
-  printf("Waiting for blockdev \"%s\" to be removed\n", blockdev);
+#include "blockdev.h"
+#include "watchset.h"
+#include "stats.h"
+#include "wait_for_blockdev_removal.h"
 
+/*
+ * Classic BPF program which only lets uevents starting with "remove@" pass, so
+ * that unrelated uevents (power supply status, input devices, udev's own
+ * "libudev" broadcasts, …) do not wake us up at all. The subsystem cannot be
+ * checked here: its offset depends on the length of the devpath, and classic
+ * BPF cannot search. Note that BPF_ABS loads are in network byte order.
+ *
+ */
+static struct sock_filter removal_filter[] = {
+    BPF_STMT(BPF_LD | BPF_W | BPF_ABS, 0),
+    BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0x72656d6f /* "remo" */, 0, 4),
+    BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 4),
+    BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0x7665 /* "ve" */, 0, 2),
+    BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 6),
+    BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, '@', 1, 0),
+    BPF_STMT(BPF_RET | BPF_K, 0),
+    BPF_STMT(BPF_RET | BPF_K, 0xffffffff),
+};
+
+/*
+ * Attaches removal_filter to fd. Failure is not fatal: the userspace matcher
+ * still checks every uevent, we just wake up more often.
+ *
+ */
+void uevent_socket_attach_filter(int fd) {
+  const struct sock_fprog prog = {
+      .len = sizeof(removal_filter) / sizeof(removal_filter[0]),
+      .filter = removal_filter,
+  };
+  if (setsockopt(fd, SOL_SOCKET, SO_ATTACH_FILTER, &prog, sizeof(prog)) ==
+      -1) {
+    warn("setsockopt(SO_ATTACH_FILTER)");
+  }
+}
+
+/*
+ * Opens a netlink socket which receives kernel uevents signaling the removal
+ * of a device. The caller owns the returned file descriptor.
+ *
+ */
+int uevent_socket_open(void) {
   struct sockaddr_nl nls;
-  struct pollfd pfd;
-  char buf[512];
 
   memset(&nls, 0, sizeof(struct sockaddr_nl));
   nls.nl_family = AF_NETLINK;
   nls.nl_pid = getpid();
   nls.nl_groups = -1;
 
-  pfd.events = POLLIN;
   // As per netlink(7), Linux 3.0 allows unprivileged users to use
   // NETLINK_KOBJECT_UEVENT.
-  pfd.fd = socket(PF_NETLINK, SOCK_DGRAM, NETLINK_KOBJECT_UEVENT);
-  if (pfd.fd == -1) {
+  const int fd = socket(PF_NETLINK, SOCK_DGRAM, NETLINK_KOBJECT_UEVENT);
+  if (fd == -1) {
     err(EXIT_FAILURE, "socket(PF_NETLINK, SOCK_DGRAM, NETLINK_KOBJECT_UEVENT)");
   }
 
-  if (bind(pfd.fd, (void *)&nls, sizeof(struct sockaddr_nl))) {
+  // Attach the filter before binding so that no unfiltered uevent gets queued.
+  uevent_socket_attach_filter(fd);
+
+  // Unplugging a hub removes dozens of devices at once. Make room for the
+  // burst; SO_RCVBUFFORCE ignores net.core.rmem_max, but requires
+  // CAP_NET_ADMIN. Overflows are still handled, see uevent_socket_read().
+  const int rcvbuf = UEVENT_RCVBUF_SIZE;
+  if (setsockopt(fd, SOL_SOCKET, SO_RCVBUFFORCE, &rcvbuf, sizeof(rcvbuf)) ==
+          -1 &&
+      setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf)) == -1) {
+    warn("setsockopt(SO_RCVBUF, %d)", rcvbuf);
+  }
+
+  if (bind(fd, (void *)&nls, sizeof(struct sockaddr_nl))) {
     err(EXIT_FAILURE, "bind");
   }
 
-  while (poll(&pfd, 1, -1) != -1) {
-    const int n = recv(pfd.fd, buf, sizeof(buf), MSG_DONTWAIT);
-    if (n == -1)
-      err(EXIT_FAILURE, "recv");
+  return fd;
+}
+
+/*
+ * Parses the uevent in buf (len bytes, as returned by recv()) without copying:
+ * the fields of ev point into buf. buf[len] must be '\0', so that a truncated
+ * last entry is terminated as well. Returns false if buf is not a kernel
+ * uevent.
+ *
+ */
+bool uevent_parse(const char *buf, size_t len, struct uevent *ev) {
+  static const struct {
+    const char *key;
+    size_t offset;
+  } keys[] = {
+      {"ACTION=", offsetof(struct uevent, action)},
+      {"DEVPATH=", offsetof(struct uevent, devpath)},
+      {"SUBSYSTEM=", offsetof(struct uevent, subsystem)},
+      {"DEVNAME=", offsetof(struct uevent, devname)},
+      {"DEVTYPE=", offsetof(struct uevent, devtype)},
+      {"MAJOR=", offsetof(struct uevent, major)},
+      {"MINOR=", offsetof(struct uevent, minor)},
+  };
+
+  memset(ev, 0, sizeof(struct uevent));
+
+  // The payload is a header line of the form action@devpath, followed by
+  // key=value entries, all separated by \0.
+  size_t off = strnlen(buf, len);
+  if (memchr(buf, '@', off) == NULL) {
+    return false;
+  }
+  for (off++; off < len; off += strnlen(buf + off, len - off) + 1) {
+    const char *entry = buf + off;
+    for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++) {
+      const size_t keylen = strlen(keys[i].key);
+      if (strncmp(entry, keys[i].key, keylen) == 0) {
+        *(const char **)((char *)ev + keys[i].offset) = entry + keylen;
+        break;
+      }
+    }
+  }
+  return ev->action != NULL && ev->devpath != NULL;
+}
+
+/*
+ * Returns the watched block device which ev signals the removal of (or the
+ * removal of a device it depends on, see resolve_blockdev_ancestry()), or NULL.
+ * Block device uevents always carry DEVNAME; MAJOR and MINOR are compared when
+ * present, so that a different device which got the name of a watched block
+ * device in the meantime cannot match.
+ *
+ */
+const struct blockdev *uevent_removed_blockdev(const struct uevent *ev,
+                                               const struct watchset *ws) {
+  if (ev->action == NULL || strcmp(ev->action, "remove") != 0) {
+    return NULL;
+  }
+  const struct blockdev *blockdev = watchset_lookup_devpath(ws, ev->devpath);
+  if (blockdev != NULL) {
+    return blockdev;
+  }
+  if (ev->subsystem == NULL || strcmp(ev->subsystem, "block") != 0 ||
+      ev->devname == NULL) {
+    return NULL;
+  }
+  for (int i = 0; i < ws->num_blockdevs; i++) {
+    blockdev = &(ws->blockdevs[i]);
+    if (strcmp(ev->devname, blockdev->name) != 0) {
+      continue;
+    }
+    if (ev->major == NULL || ev->minor == NULL ||
+        makedev(strtoul(ev->major, NULL, 10), strtoul(ev->minor, NULL, 10)) ==
+            blockdev->devnum) {
+      return blockdev;
+    }
+  }
+  return NULL;
+}
+
+/*
+ * Returns one end of a socketpair on which a uevent signaling the removal of
+ * blockdev is queued, for rehearsing the removal (see mlock_record()).
+ *
+ */
+int uevent_socket_fake_removal(const struct blockdev *blockdev) {
+  int fds[2];
+  if (socketpair(AF_UNIX, SOCK_DGRAM, 0, fds) == -1) {
+    err(EXIT_FAILURE, "socketpair");
+  }
+  char buf[UEVENT_RECV_SIZE];
+  const int len = snprintf(buf, sizeof(buf),
+                           "remove@/fake/%s%cACTION=remove%cDEVPATH=/fake/%s%c"
+                           "SUBSYSTEM=block%cDEVNAME=%s%c",
+                           blockdev->name, '\0', '\0', blockdev->name, '\0',
+                           '\0', blockdev->name, '\0');
+  if (send(fds[1], buf, len + 1, 0) == -1) {
+    err(EXIT_FAILURE, "send");
+  }
+  close(fds[1]);
+  return fds[0];
+}
+
+/*
+ * Checks sysfs for every block device in ws and every one of its device paths
+ * and returns the first block device which is gone, or NULL if all of them are
+ * still present. This is what a lost uevent would have told us. The block
+ * device itself is looked up by its number, which also works if it vanished
+ * before resolve_blockdev_ancestry() could find its device paths.
+ *
+ */
+const struct blockdev *find_vanished_blockdev(const struct watchset *ws) {
+  char path[PATH_MAX];
+  for (int i = 0; i < ws->num_blockdevs; i++) {
+    const struct blockdev *blockdev = &ws->blockdevs[i];
+    snprintf(path, sizeof(path), "/sys/dev/block/%u:%u",
+             major(blockdev->devnum), minor(blockdev->devnum));
+    if (access(path, F_OK) == -1 && errno == ENOENT) {
+      printf("\"%s\" is gone from sysfs\n", path);
+      return blockdev;
+    }
+    for (int j = 0; j < blockdev->num_devpaths; j++) {
+      snprintf(path, sizeof(path), "/sys%s", blockdev->devpaths[j]);
+      if (access(path, F_OK) == -1 && errno == ENOENT) {
+        printf("\"%s\" is gone from sysfs\n", path);
+        return blockdev;
+      }
+    }
+  }
+  return NULL;
+}
+
+/*
+ * Receives up to UEVENT_BATCH_SIZE uevents queued on fd with one recvmmsg()
+ * call, without blocking, into static buffers which batch points to (and
+ * which the next call overwrites). Returns the number of uevents received, 0
+ * if none were queued, or -1 if the kernel dropped uevents because the
+ * receive buffer was full.
+ *
+ */
+int uevent_socket_recv(int fd, struct uevent_batch *batch) {
+  // The kernel limits the key=value part to UEVENT_BUFFER_SIZE (2048 bytes),
+  // the header line is bounded by the devpath length. A longer uevent would
+  // be reported with MSG_TRUNC, so a truncation would not go unnoticed.
+  static char bufs[UEVENT_BATCH_SIZE][UEVENT_RECV_SIZE + 1];
+  static struct iovec iovs[UEVENT_BATCH_SIZE];
+  static struct mmsghdr msgs[UEVENT_BATCH_SIZE];
+
+  batch->num = 0;
+  for (int i = 0; i < UEVENT_BATCH_SIZE; i++) {
+    iovs[i] = (struct iovec){.iov_base = bufs[i], .iov_len = UEVENT_RECV_SIZE};
+    msgs[i] =
+        (struct mmsghdr){.msg_hdr = {.msg_iov = &iovs[i], .msg_iovlen = 1}};
+  }
+  const int n = recvmmsg(fd, msgs, UEVENT_BATCH_SIZE, MSG_DONTWAIT, NULL);
+  if (n == -1) {
+    if (errno == ENOBUFS)
+      return -1;
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+      return 0;
+    err(EXIT_FAILURE, "recvmmsg");
+  }
+
+  for (int i = 0; i < n; i++) {
+    const size_t len = msgs[i].msg_len;
+    if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+      warnx("uevent truncated to %d bytes", UEVENT_RECV_SIZE);
+    }
+    bufs[i][len] = '\0';
+    batch->bufs[i] = bufs[i];
+    batch->lens[i] = len;
+  }
+  batch->num = n;
+  return n;
+}
 
+/*
+ * Returns the first block device in ws whose removal one of the uevents in
+ * batch signals, and stores the index of that uevent in *matched (unless
+ * matched is NULL). Returns NULL if none did.
+ *
+ */
+const struct blockdev *uevent_batch_match(const struct uevent_batch *batch,
+                                          const struct watchset *ws,
+                                          int *matched) {
+  for (int i = 0; i < batch->num; i++) {
+    const char *buf = batch->bufs[i];
+    const size_t len = batch->lens[i];
+    if (len == 0)
+      continue;
+
+    stats.uevents_received++;
     printf("Read hotplug event, first line is \"%s\"\n", buf);
-    const size_t len = strlen(buf);
-    // If the line starts with remove@ and ends in the block device, the block
-    // device was removed.
-    if (strncmp(buf, "remove@", strlen("remove@")) == 0 &&
-        len > strlen(blockdev) &&
-        strcmp(buf + len - strlen(blockdev), blockdev) == 0) {
-      close(pfd.fd);
-      return;
+    struct uevent ev;
+    const struct blockdev *removed;
+    if (uevent_parse(buf, len, &ev) &&
+        (removed = uevent_removed_blockdev(&ev, ws)) != NULL) {
+      stats.uevents_matched++;
+      if (matched != NULL)
+        *matched = i;
+      return removed;
+    }
+  }
+  return NULL;
+}
+
+/*
+ * Reads all uevents queued on fd without blocking, UEVENT_BATCH_SIZE per
+ * recvmmsg() call, so that it can be driven by the event loop in main().
+ * Returns the first block device in ws whose removal one of them signals, NULL
+ * if none did.
+ *
+ * If the kernel dropped uevents because the receive buffer was full, the
+ * removal might have been among them, so sysfs is checked instead and
+ * *overflowed is set. The caller has to check sysfs once more after
+ * UEVENT_RECHECK_MS: the kernel sends the remove uevent before it deletes the
+ * device from sysfs, so the first check can still find it.
+ *
+ */
+const struct blockdev *uevent_socket_read(int fd, const struct watchset *ws,
+                                          bool *overflowed) {
+  struct uevent_batch batch;
+  for (;;) {
+    const int n = uevent_socket_recv(fd, &batch);
+    if (n == -1) {
+      warnx("uevents were lost (receive buffer full), checking sysfs");
+      *overflowed = true;
+      const struct blockdev *removed = find_vanished_blockdev(ws);
+      if (removed != NULL)
+        return removed;
+      continue;
     }
+    const struct blockdev *removed = uevent_batch_match(&batch, ws, NULL);
+    if (removed != NULL)
+      return removed;
+    // A partial batch means the queue is empty.
+    if (n < UEVENT_BATCH_SIZE)
+      return NULL;
   }
 }
@@ -1,3 +1,48 @@
 #pragma once
 
-void wait_for_blockdev_removal(const char *blockdev);
+/* Size of the buffer uevents are received into. */
+#define UEVENT_RECV_SIZE 8192
+
+/* How many uevents are received with one recvmmsg() call */
+#define UEVENT_BATCH_SIZE 16
+
+/* Receive buffer of the uevent socket, to survive bursts of uevents */
+#define UEVENT_RCVBUF_SIZE (4 * 1024 * 1024)
+
+/* Delay of the second sysfs check after lost uevents, see
+ * uevent_socket_read() */
+#define UEVENT_RECHECK_MS 500
+
+/* The fields root-vanished looks at, pointing into the received buffer. NULL
+ * if the uevent does not carry the corresponding key. */
+struct uevent {
+  const char *action;
+  const char *devpath;
+  const char *subsystem;
+  const char *devname;
+  const char *devtype;
+  const char *major;
+  const char *minor;
+};
+
+/* uevents received by uevent_socket_recv() */
+struct uevent_batch {
+  int num;
+  /* '\0'-terminated, see uevent_parse() */
+  const char *bufs[UEVENT_BATCH_SIZE];
+  size_t lens[UEVENT_BATCH_SIZE];
+};
+
+void uevent_socket_attach_filter(int fd);
+int uevent_socket_open(void);
+int uevent_socket_fake_removal(const struct blockdev *blockdev);
+bool uevent_parse(const char *buf, size_t len, struct uevent *ev);
+const struct blockdev *uevent_removed_blockdev(const struct uevent *ev,
+                                               const struct watchset *ws);
+const struct blockdev *find_vanished_blockdev(const struct watchset *ws);
+int uevent_socket_recv(int fd, struct uevent_batch *batch);
+const struct blockdev *uevent_batch_match(const struct uevent_batch *batch,
+                                          const struct watchset *ws,
+                                          int *matched);
+const struct blockdev *uevent_socket_read(int fd, const struct watchset *ws,
+                                          bool *overflowed);
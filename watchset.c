@@ -0,0 +1,108 @@
+/*
+ * Copyright 2016 Google Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <err.h>
+#include <sys/types.h>
+
+#include "blockdev.h"
+#include "watchset.h"
+
+/* FNV-1a, 32 bit */
+static uint32_t hash_devpath(const char *devpath) {
+  uint32_t hash = 2166136261u;
+  for (const unsigned char *c = (const unsigned char *)devpath; *c; c++) {
+    hash = (hash ^ *c) * 16777619u;
+  }
+  return hash;
+}
+
+/*
+ * Adds a copy of blockdev to the watchset. Call watchset_build() once all
+ * block devices were added (and again after adding more later on).
+ *
+ */
+void watchset_add(struct watchset *ws, const struct blockdev *blockdev) {
+  ws->blockdevs = realloc(ws->blockdevs, (ws->num_blockdevs + 1) *
+                                             sizeof(struct blockdev));
+  if (ws->blockdevs == NULL) {
+    err(EXIT_FAILURE, "realloc");
+  }
+  ws->blockdevs[ws->num_blockdevs++] = *blockdev;
+}
+
+/*
+ * (Re-)builds the devpath hash table. The table is kept at most half full so
+ * that probe sequences stay short.
+ *
+ */
+void watchset_build(struct watchset *ws) {
+  uint32_t num_devpaths = 0;
+  for (int i = 0; i < ws->num_blockdevs; i++) {
+    num_devpaths += ws->blockdevs[i].num_devpaths;
+  }
+  free(ws->slots);
+  ws->num_slots = 16;
+  while (ws->num_slots < 2 * num_devpaths) {
+    ws->num_slots *= 2;
+  }
+  if ((ws->slots = calloc(ws->num_slots, sizeof(struct watchset_slot))) ==
+      NULL) {
+    err(EXIT_FAILURE, "calloc");
+  }
+
+  for (int i = 0; i < ws->num_blockdevs; i++) {
+    const struct blockdev *blockdev = &(ws->blockdevs[i]);
+    for (int j = 0; j < blockdev->num_devpaths; j++) {
+      const char *devpath = blockdev->devpaths[j];
+      if (watchset_lookup_devpath(ws, devpath) != NULL) {
+        /* Shared parent (e.g. the USB hub), the first block device wins. */
+        continue;
+      }
+      const uint32_t hash = hash_devpath(devpath);
+      uint32_t slot = hash & (ws->num_slots - 1);
+      while (ws->slots[slot].devpath != NULL) {
+        slot = (slot + 1) & (ws->num_slots - 1);
+      }
+      ws->slots[slot] = (struct watchset_slot){
+          .hash = hash, .devpath = devpath, .blockdev = i,
+      };
+    }
+  }
+}
+
+/*
+ * Returns the watched block device which depends on the device at devpath, or
+ * NULL if there is none.
+ *
+ */
+const struct blockdev *watchset_lookup_devpath(const struct watchset *ws,
+                                               const char *devpath) {
+  if (ws->num_slots == 0) {
+    return NULL;
+  }
+  const uint32_t hash = hash_devpath(devpath);
+  for (uint32_t slot = hash & (ws->num_slots - 1);
+       ws->slots[slot].devpath != NULL;
+       slot = (slot + 1) & (ws->num_slots - 1)) {
+    if (ws->slots[slot].hash == hash &&
+        strcmp(ws->slots[slot].devpath, devpath) == 0) {
+      return &(ws->blockdevs[ws->slots[slot].blockdev]);
+    }
+  }
+  return NULL;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+/* All block devices root-vanished watches, with a hash table over all of
+ * their devpaths so that each uevent costs one lookup. */
+struct watchset {
+  struct blockdev *blockdevs;
+  int num_blockdevs;
+  /* Open addressing, linear probing, num_slots is a power of two. */
+  struct watchset_slot {
+    uint32_t hash;
+    const char *devpath;
+    /* Index into blockdevs, which watchset_add() may move */
+    int blockdev;
+  } *slots;
+  uint32_t num_slots;
+};
+
+void watchset_add(struct watchset *ws, const struct blockdev *blockdev);
+void watchset_build(struct watchset *ws);
+const struct blockdev *watchset_lookup_devpath(const struct watchset *ws,
+                                               const char *devpath);